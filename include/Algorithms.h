@@ -1,9 +1,14 @@
 #ifndef ALGORITHMS_H
 #define ALGORITHMS_H
 
+#include "Arena.h"
 #include "Graph.h"
 #include "MinHeap.h"
+#include "SimpleBitset.h"
 #include "SimpleVector.h"
+#include "SmallVector.h"
+#include "Span.h"
+#include "StringView.h"
 #include "DataStructs.h"
 #include <cmath>
 #include <string>
@@ -18,6 +23,10 @@ enum SearchMode {
     MODE_ASTAR_TIME
 };
 
+// Search frontier heaps are 4-ary: half the depth of a binary heap, and
+// the children compared at each level sit next to each other in memory
+const int SEARCH_HEAP_ARITY = 4;
+
 struct DijkstraState {
     int u;
     double currentMetric;
@@ -36,13 +45,23 @@ struct DijkstraState {
     }
 };
 
+// Port indices along a route; most answers are a handful of hops and fit inline
+const int PATH_INLINE_PORTS = 16;
+
 struct PathResult {
-    SimpleVector<int> path;
+    SmallVector<int, PATH_INLINE_PORTS> path;
     double totalCost;
 
     PathResult() : totalCost(0) {}
 };
 
+// Scratch memory for search workspaces, reused from one query to the next.
+// Each search rewinds it on return, so nested searches stack safely.
+inline Arena& queryArena() {
+    thread_local Arena arena;
+    return arena;
+}
+
 inline double calculateHeuristic(Graph& g, int currentIdx, int targetIdx, SearchMode mode) {
     if (mode == MODE_DIJKSTRA_COST || mode == MODE_DIJKSTRA_TIME) {
         return 0.0;
@@ -63,38 +82,35 @@ inline double calculateHeuristic(Graph& g, int currentIdx, int targetIdx, Search
     return 0.0;
 }
 
-inline PathResult findPath(Graph& g, string startName, string endName, SearchMode mode, int startDay = 1) {
+// Earliest journey whose first sailing leaves on startDate
+inline PathResult findPath(Graph& g, int startIdx, int endIdx, SearchMode mode, Date startDate) {
     PathResult result;
 
-    int startIdx = g.getIndex(startName);
-    int endIdx = g.getIndex(endName);
-
-    if (startIdx == -1 || endIdx == -1) {
+    if (startIdx < 0 || startIdx >= g.ports.size() || endIdx < 0 || endIdx >= g.ports.size()) {
         return result;
     }
 
     int n = g.ports.size();
 
-    SimpleVector<double> minMetric;
-    SimpleVector<double> arrivalTimes;
-    SimpleVector<int> parent;
-    SimpleVector<bool> visited;
+    ArenaScope scratch(queryArena());
+    SimpleVector<double> minMetric(&scratch.arena);
+    SimpleVector<double> arrivalTimes(&scratch.arena);
+    SimpleVector<int> parent(&scratch.arena);
+    SimpleBitset visited(&scratch.arena);
 
-    for (int i = 0; i < n; i++) {
-        minMetric.push_back(1e18);
-        arrivalTimes.push_back(1e18);
-        parent.push_back(-1);
-        visited.push_back(false);
-    }
+    minMetric.resize(n, 1e18);
+    arrivalTimes.resize(n, 1e18);
+    parent.resize(n, -1);
+    visited.resize(n);
 
     arrivalTimes[startIdx] = 0.0;
     minMetric[startIdx] = 0.0;
     
-    double decemberStartMinutes = 482400.0;
-    double dayStartMinutes = decemberStartMinutes + (startDay - 1) * 1440.0;
-    double dayEndMinutes = decemberStartMinutes + startDay * 1440.0 - 1.0;
+    long long dayStartMinutes = dateTimeToMinutes(startDate, 0);
+    long long dayEndMinutes = dayStartMinutes + 1439;
 
-    MinHeap<DijkstraState> pq;
+    MinHeap<DijkstraState, SEARCH_HEAP_ARITY> pq(&scratch.arena);
+    pq.reserve(n);
     double h = calculateHeuristic(g, startIdx, endIdx, mode);
     pq.push(DijkstraState(startIdx, minMetric[startIdx], minMetric[startIdx] + h));
 
@@ -104,10 +120,9 @@ inline PathResult findPath(Graph& g, string startName, string endName, SearchMod
 
         int u = current.u;
 
-        if (visited[u]) {
+        if (visited.testAndSet(u)) {
             continue;
         }
-        visited[u] = true;
 
         if (u == endIdx) {
             break;
@@ -118,40 +133,26 @@ inline PathResult findPath(Graph& g, string startName, string endName, SearchMod
             Edge& edge = edgeNode->data;
             int v = edge.destinationPortIndex;
 
-            if (!visited[v]) {
+            if (!visited.test(v)) {
                 Route* route = edge.routeData;
                 
-                Date depDate = parseDate(route->departureDate);
-                int depTimeMin = timeToMinutes(route->depTime);
-                long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-
-                Date arrDate = parseDate(route->departureDate);
-                int arrTimeMin = timeToMinutes(route->arrTime);
-                long long arrivalDatetime = dateTimeToMinutes(arrDate, arrTimeMin);
-
-                if (arrTimeMin < depTimeMin) {
-                    arrivalDatetime += 1440;
-                }
+                long long departureDatetime = route->departureDatetime;
+                long long arrivalDatetime = route->arrivalDatetime;
 
                 double currentArrival = arrivalTimes[u];
 
                 if (u == startIdx) {
+                    if (g.timetable == TIMETABLE_WEEKLY) {
+                        alignSailing(g.timetable, departureDatetime, arrivalDatetime, dayStartMinutes);
+                    }
                     if (departureDatetime < dayStartMinutes || departureDatetime > dayEndMinutes) {
                         edgeNode = edgeNode->next;
                         continue;
                     }
                     currentArrival = (double)departureDatetime;
                 } else {
-                    int cycleCount = 0;
-                    int maxCycles = 1;
-                    
-                    while (departureDatetime < currentArrival && cycleCount < maxCycles) {
-                        departureDatetime += 10080;
-                        arrivalDatetime += 10080;
-                        cycleCount++;
-                    }
-                    
-                    if (departureDatetime < currentArrival) {
+                    // Dated sailings may be caught on their next weekly repeat at most
+                    if (!alignSailing(g.timetable, departureDatetime, arrivalDatetime, currentArrival, 1)) {
                         edgeNode = edgeNode->next;
                         continue;
                     }
@@ -205,13 +206,14 @@ inline PathResult findPath(Graph& g, string startName, string endName, SearchMod
         return result;
     }
 
-    SimpleVector<int> reversePath;
+    SmallVector<int, PATH_INLINE_PORTS> reversePath;
     int current = endIdx;
     while (current != -1) {
         reversePath.push_back(current);
         current = parent[current];
     }
 
+    result.path.reserve(reversePath.size());
     for (int i = reversePath.size() - 1; i >= 0; i--) {
         result.path.push_back(reversePath[i]);
     }
@@ -221,43 +223,45 @@ inline PathResult findPath(Graph& g, string startName, string endName, SearchMod
     return result;
 }
 
+// Same, by port name
+inline PathResult findPath(Graph& g, StringView startName, StringView endName, SearchMode mode, Date startDate) {
+    return findPath(g, g.getIndex(startName), g.getIndex(endName), mode, startDate);
+}
+
 struct MultiLegResult {
     SimpleVector<PathResult> segments;
     bool isValid;
-    int departureDay;
+    Date departureDate;
     double totalCostWithCharges;
 
-    MultiLegResult() : isValid(true), departureDay(1), totalCostWithCharges(0.0) {}
+    MultiLegResult() : isValid(true), departureDate{1, 1, 1970}, totalCostWithCharges(0.0) {}
 };
 
-inline PathResult findPathSegment(Graph& g, string startName, string endName, SearchMode mode, double absoluteStartTimeMin) {
+inline PathResult findPathSegment(Graph& g, int startIdx, int endIdx, SearchMode mode, double absoluteStartTimeMin) {
     PathResult result;
 
-    int startIdx = g.getIndex(startName);
-    int endIdx = g.getIndex(endName);
-
-    if (startIdx == -1 || endIdx == -1) {
+    if (startIdx < 0 || startIdx >= g.ports.size() || endIdx < 0 || endIdx >= g.ports.size()) {
         return result;
     }
 
     int n = g.ports.size();
 
-    SimpleVector<double> minMetric;
-    SimpleVector<double> arrivalTimes;
-    SimpleVector<int> parent;
-    SimpleVector<bool> visited;
+    ArenaScope scratch(queryArena());
+    SimpleVector<double> minMetric(&scratch.arena);
+    SimpleVector<double> arrivalTimes(&scratch.arena);
+    SimpleVector<int> parent(&scratch.arena);
+    SimpleBitset visited(&scratch.arena);
 
-    for (int i = 0; i < n; i++) {
-        minMetric.push_back(1e18);
-        arrivalTimes.push_back(1e18);
-        parent.push_back(-1);
-        visited.push_back(false);
-    }
+    minMetric.resize(n, 1e18);
+    arrivalTimes.resize(n, 1e18);
+    parent.resize(n, -1);
+    visited.resize(n);
 
     arrivalTimes[startIdx] = absoluteStartTimeMin;
     minMetric[startIdx] = 0.0;
 
-    MinHeap<DijkstraState> pq;
+    MinHeap<DijkstraState, SEARCH_HEAP_ARITY> pq(&scratch.arena);
+    pq.reserve(n);
     double h = calculateHeuristic(g, startIdx, endIdx, mode);
     pq.push(DijkstraState(startIdx, minMetric[startIdx], minMetric[startIdx] + h));
 
@@ -267,8 +271,7 @@ inline PathResult findPathSegment(Graph& g, string startName, string endName, Se
 
         int u = current.u;
 
-        if (visited[u]) continue;
-        visited[u] = true;
+        if (visited.testAndSet(u)) continue;
 
         if (u == endIdx) break;
 
@@ -277,36 +280,15 @@ inline PathResult findPathSegment(Graph& g, string startName, string endName, Se
             int v = edge->data.destinationPortIndex;
             Route* route = edge->data.routeData;
 
-            Date depDate = parseDate(route->departureDate);
-            int depTimeMin = timeToMinutes(route->depTime);
-            int arrTimeMin = timeToMinutes(route->arrTime);
-
-            long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-            long long arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
-
-            if (arrTimeMin < depTimeMin) {
-                arrivalDatetime += 1440;
-            }
-
-            bool feasible = false;
-            double waitTime = 0.0;
-
-            if (u == startIdx) {
-                if (departureDatetime >= absoluteStartTimeMin) {
-                    feasible = true;
-                    waitTime = departureDatetime - absoluteStartTimeMin;
-                }
-            } else {
-                if (departureDatetime >= arrivalTimes[u]) {
-                    feasible = true;
-                    waitTime = departureDatetime - arrivalTimes[u];
-                }
-            }
+            long long departureDatetime = route->departureDatetime;
+            long long arrivalDatetime = route->arrivalDatetime;
 
-            if (!feasible) {
+            // arrivalTimes[startIdx] is the requested start time
+            if (!alignSailing(g.timetable, departureDatetime, arrivalDatetime, arrivalTimes[u], 0)) {
                 edge = edge->next;
                 continue;
             }
+            double waitTime = departureDatetime - arrivalTimes[u];
 
             double edgeWeight = 0.0;
             if (mode == MODE_DIJKSTRA_COST || mode == MODE_ASTAR_COST) {
@@ -337,13 +319,14 @@ inline PathResult findPathSegment(Graph& g, string startName, string endName, Se
         return result;
     }
 
-    SimpleVector<int> reversePath;
+    SmallVector<int, PATH_INLINE_PORTS> reversePath;
     int current = endIdx;
     while (current != -1) {
         reversePath.push_back(current);
         current = parent[current];
     }
 
+    result.path.reserve(reversePath.size());
     for (int i = reversePath.size() - 1; i >= 0; i--) {
         result.path.push_back(reversePath[i]);
     }
@@ -353,10 +336,15 @@ inline PathResult findPathSegment(Graph& g, string startName, string endName, Se
     return result;
 }
 
-inline MultiLegResult calculateMultiLegRoute(Graph& g, const SimpleVector<string>& stops, SearchMode mode, int startDay = 1) {
+inline PathResult findPathSegment(Graph& g, StringView startName, StringView endName, SearchMode mode, double absoluteStartTimeMin) {
+    return findPathSegment(g, g.getIndex(startName), g.getIndex(endName), mode, absoluteStartTimeMin);
+}
+
+// stops are port indices, resolved once by the caller
+inline MultiLegResult calculateMultiLegRoute(Graph& g, Span<int> stops, SearchMode mode, Date startDate) {
     MultiLegResult result;
     result.isValid = true;
-    result.departureDay = startDay;
+    result.departureDate = startDate;
     result.totalCostWithCharges = 0.0;
 
     if (stops.size() < 2) {
@@ -364,15 +352,14 @@ inline MultiLegResult calculateMultiLegRoute(Graph& g, const SimpleVector<string
         return result;
     }
 
-    double decemberStartMinutes = 482400.0;
-    double currentArrivalTime = decemberStartMinutes + (startDay - 1) * 1440.0;
-    int finalDestIdx = g.getIndex(stops[stops.size() - 1]);
+    double currentArrivalTime = (double)dateTimeToMinutes(startDate, 0);
+    int finalDestIdx = stops[stops.size() - 1];
     
     for (int legIdx = 0; legIdx < stops.size() - 1; legIdx++) {
         PathResult segment;
         
         if (legIdx == 0) {
-            segment = findPath(g, stops[legIdx], stops[legIdx + 1], mode, startDay);
+            segment = findPath(g, stops[legIdx], stops[legIdx + 1], mode, startDate);
         } else {
             segment = findPathSegment(g, stops[legIdx], stops[legIdx + 1], mode, currentArrivalTime);
         }
@@ -397,21 +384,10 @@ inline MultiLegResult calculateMultiLegRoute(Graph& g, const SimpleVector<string
                     
                     segmentCost += edge->data.weight;
                     
-                    Date depDate = parseDate(route->departureDate);
-                    int depTimeMin = timeToMinutes(route->depTime);
-                    int arrTimeMin = timeToMinutes(route->arrTime);
+                    long long departureDatetime = route->departureDatetime;
+                    long long arrivalDatetime = route->arrivalDatetime;
                     
-                    long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-                    long long arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
-                    
-                    if (arrTimeMin < depTimeMin) {
-                        arrivalDatetime += 1440;
-                    }
-                    
-                    while (departureDatetime < legArrivalTime) {
-                        departureDatetime += 10080;
-                        arrivalDatetime += 10080;
-                    }
+                    alignSailing(g.timetable, departureDatetime, arrivalDatetime, legArrivalTime);
                     
                     double waitTime = departureDatetime - legArrivalTime;
                     
@@ -443,7 +419,7 @@ inline MultiLegResult calculateMultiLegRoute(Graph& g, const SimpleVector<string
         }
         
         segment.totalCost = segmentTime;
-        result.segments.push_back(segment);
+        result.segments.push_back(std::move(segment));
         result.totalCostWithCharges += segmentCost;
         
         currentArrivalTime = legArrivalTime;
@@ -452,4 +428,21 @@ inline MultiLegResult calculateMultiLegRoute(Graph& g, const SimpleVector<string
     return result;
 }
 
+// Same, by port name; each name is looked up once
+inline MultiLegResult calculateMultiLegRoute(Graph& g, const SimpleVector<string>& stopNames, SearchMode mode, Date startDate) {
+    SmallVector<int, PATH_INLINE_PORTS> stops;
+    stops.reserve(stopNames.size());
+    for (int i = 0; i < stopNames.size(); i++) {
+        int idx = g.getIndex(stopNames[i]);
+        if (idx == -1) {
+            MultiLegResult result;
+            result.isValid = false;
+            result.departureDate = startDate;
+            return result;
+        }
+        stops.push_back(idx);
+    }
+    return calculateMultiLegRoute(g, Span<int>(stops), mode, startDate);
+}
+
 #endif
\ No newline at end of file
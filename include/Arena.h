@@ -0,0 +1,107 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Bump-pointer arena for short-lived scratch memory (one search, one
+// frame). Allocating bumps an offset inside the current block; nothing is
+// freed one by one. rewind() or reset() make the space reusable, and the
+// blocks are kept, so a warmed-up arena stops calling the system allocator.
+struct Arena {
+    static const size_t DEFAULT_BLOCK_BYTES = 64 * 1024;
+
+    struct Block {
+        Block* next;
+        size_t size;  // Usable bytes after the header
+        alignas(16) char memory[1];
+    };
+
+    // A position to rewind to
+    struct Marker {
+        Block* block;
+        size_t used;
+    };
+
+    Block* first = nullptr;
+    Block* current = nullptr;   // Block being filled (nullptr before the first allocation)
+    size_t used = 0;            // Bytes used in current
+    int blockAllocations = 0;   // System allocations made so far, for measuring
+
+    Arena() {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        while (first != nullptr) {
+            Block* next = first->next;
+            ::operator delete(first);
+            first = next;
+        }
+    }
+
+    // align must be a power of two
+    void* allocate(size_t bytes, size_t align) {
+        if (current != nullptr) {
+            // Align the address, not the offset: memory is only 16-aligned
+            uintptr_t base = reinterpret_cast<uintptr_t>(current->memory);
+            size_t offset = ((base + used + align - 1) & ~(uintptr_t(align) - 1)) - base;
+            if (offset + bytes <= current->size) {
+                used = offset + bytes;
+                return current->memory + offset;
+            }
+        }
+        return allocateInNextBlock(bytes, align);
+    }
+
+    // Move on to the block after current, replacing it if it is too small
+    void* allocateInNextBlock(size_t bytes, size_t align) {
+        size_t need = bytes + align;
+        Block** link = (current != nullptr) ? &current->next : &first;
+        Block* next = *link;
+        if (next == nullptr || next->size < need) {
+            size_t size = need > DEFAULT_BLOCK_BYTES ? need : DEFAULT_BLOCK_BYTES;
+            Block* block = static_cast<Block*>(::operator new(offsetof(Block, memory) + size));
+            block->size = size;
+            block->next = (next != nullptr) ? next->next : nullptr;
+            if (next != nullptr) ::operator delete(next);
+            *link = block;
+            next = block;
+            blockAllocations++;
+        }
+        current = next;
+        size_t misalign = reinterpret_cast<uintptr_t>(current->memory) & (align - 1);
+        size_t offset = misalign ? align - misalign : 0;
+        used = offset + bytes;
+        return current->memory + offset;
+    }
+
+    Marker mark() const {
+        return {current, used};
+    }
+
+    // Forget everything allocated since m; the memory is reused by later allocations
+    void rewind(Marker m) {
+        current = m.block;
+        used = m.used;
+    }
+
+    void reset() {
+        current = nullptr;
+        used = 0;
+    }
+};
+
+// Rewinds an arena to where it was when the scope began; nests safely
+struct ArenaScope {
+    Arena& arena;
+    Arena::Marker start;
+
+    explicit ArenaScope(Arena& a) : arena(a), start(a.mark()) {}
+    ~ArenaScope() {
+        arena.rewind(start);
+    }
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef CONCURRENTQUEUE_H
+#define CONCURRENTQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+// Bounded lock-free multi-producer/multi-consumer queue (Dmitry Vyukov's
+// design). Each cell carries a sequence number saying whose turn it is:
+// a producer may fill cell i when sequence == position, a consumer may
+// empty it when sequence == position + 1. Producers and consumers only
+// contend on their own position counter, claimed with one CAS.
+//
+// tryPush/tryPop never block: they return false when the queue is full
+// or empty and leave the argument untouched.
+template <typename T>
+struct ConcurrentQueue {
+    struct Cell {
+        atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* item() {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    Cell* cells;
+    size_t mask;
+
+    // Separate cache lines so producers and consumers do not false-share
+    alignas(64) atomic<size_t> enqueuePos;
+    alignas(64) atomic<size_t> dequeuePos;
+
+    // Capacity is rounded up to a power of two (at least 2)
+    explicit ConcurrentQueue(int capacity) {
+        size_t size = 2;
+        while (size < static_cast<size_t>(capacity)) size *= 2;
+        cells = new Cell[size];
+        for (size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+        mask = size - 1;
+        enqueuePos.store(0, memory_order_relaxed);
+        dequeuePos.store(0, memory_order_relaxed);
+    }
+
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    // No other thread may be using the queue by now
+    ~ConcurrentQueue() {
+        size_t end = enqueuePos.load(memory_order_relaxed);
+        for (size_t pos = dequeuePos.load(memory_order_relaxed); pos != end; pos++) {
+            cells[pos & mask].item()->~T();
+        }
+        delete[] cells;
+    }
+
+    int capacity() const {
+        return static_cast<int>(mask + 1);
+    }
+
+    template <typename U>
+    bool tryPush(U&& value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // Full: the consumer has not emptied this cell yet
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+        new (cell->item()) T(std::forward<U>(value));
+        cell->sequence.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // Empty: no producer has filled this cell yet
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+        T* item = cell->item();
+        out = std::move(*item);
+        item->~T();
+        cell->sequence.store(pos + mask + 1, memory_order_release);
+        return true;
+    }
+
+    // Snapshot of the element count; may be stale as soon as it returns
+    int approxSize() const {
+        size_t head = dequeuePos.load(memory_order_relaxed);
+        size_t tail = enqueuePos.load(memory_order_relaxed);
+        return tail > head ? static_cast<int>(tail - head) : 0;
+    }
+};
+
+#endif
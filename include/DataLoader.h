@@ -0,0 +1,172 @@
+#ifndef DATALOADER_H
+#define DATALOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "SimpleVector.h"
+#include "DataStructs.h"
+#include "FileParser.h"
+#include "Graph.h"
+#include "GraphSnapshot.h"
+
+using namespace std;
+
+// Input files for a load
+struct LoadPaths {
+    string portsFile;
+    string routesFile;          // .cols = columnar route feed
+    string coordinatesFile;
+    string snapshotFile;
+    string mapImageFile;
+    string iconImageFile;
+    string fontFile;
+};
+
+// Loads assets and builds the graph on a background thread so the window
+// can open straight away. Images are only decoded here; textures must be
+// created on the UI thread, which owns the OpenGL context. Each ready flag
+// is set once its outputs are complete, and the loader never touches them
+// again, so the UI thread may read them freely after seeing the flag.
+struct DataLoader {
+    LoadPaths paths;
+    bool weeklyTimetable = false;
+
+    // Asset outputs (valid once assetsReady)
+    sf::Image mapImage;
+    sf::Image iconImage;
+    string fontBytes;           // sf::Font::loadFromMemory needs these to outlive the font
+
+    // Data outputs (valid once graphReady); edges point into routes
+    SimpleVector<Route> routes;
+    Graph graph;
+
+    atomic<bool> assetsReady{false};
+    atomic<bool> graphReady{false};
+    atomic<int> progress{0};                // Percent of the whole load
+    atomic<const char*> status{"Starting"};
+
+    thread* worker = nullptr;
+
+    ~DataLoader() {
+        join();
+    }
+
+    void start() {
+        worker = new thread(&DataLoader::run, this);
+    }
+
+    // Wait for the load to finish (it cannot be interrupted mid-parse)
+    void join() {
+        if (worker != nullptr) {
+            worker->join();
+            delete worker;
+            worker = nullptr;
+        }
+    }
+
+    void setStage(const char* text, int percent) {
+        status = text;
+        progress = percent;
+    }
+
+    void run() {
+        setStage("Loading assets", 0);
+        loadAssets();
+        assetsReady = true;
+
+        loadGraph();
+
+        setStage("Initializing port traffic", 95);
+        graph.initializeTraffic();
+        graph.displayGraph();
+
+        setStage("Ready", 100);
+        graphReady = true;
+    }
+
+    void loadAssets() {
+        if (!mapImage.loadFromFile(paths.mapImageFile)) {
+            cout << "Error: Could not load " << paths.mapImageFile << endl;
+        }
+        if (!iconImage.loadFromFile(paths.iconImageFile)) {
+            cout << "Warning: Could not load " << paths.iconImageFile << endl;
+        }
+        ifstream fontIn(paths.fontFile, ios::binary);
+        if (fontIn.is_open()) {
+            stringstream buffer;
+            buffer << fontIn.rdbuf();
+            fontBytes = buffer.str();
+        } else {
+            cout << "Warning: Could not load font " << paths.fontFile << endl;
+        }
+    }
+
+    // Snapshot first; otherwise parse the text (or columnar) sources and cache a snapshot
+    void loadGraph() {
+        GraphSnapshot snapshot;
+
+        setStage("Reading graph snapshot", 10);
+        if (snapshot.load(paths.snapshotFile, paths.portsFile, paths.routesFile, paths.coordinatesFile, graph, routes)) {
+            cout << "Loaded graph snapshot " << paths.snapshotFile << endl;
+            cout << "Total Ports Loaded: " << graph.ports.size() << endl;
+            cout << "Total Routes Loaded: " << routes.size() << endl;
+        } else {
+            SimpleVector<Port> ports;
+            FileParser parser;
+
+            setStage("Loading ports", 20);
+            cout << "Loading Ports..." << endl;
+            parser.loadPortCoordinates(paths.coordinatesFile);
+            parser.loadPorts(paths.portsFile, ports);
+
+            setStage("Loading routes", 30);
+            cout << "Loading Routes..." << endl;
+            const string& routesFile = paths.routesFile;
+            bool routesComplete = true;
+            if (routesFile.size() > 5 && routesFile.compare(routesFile.size() - 5, 5, ".cols") == 0) {
+                routesComplete = parser.loadRoutesColumnar(routesFile, ports, routes);
+                if (!routesComplete) {
+                    cout << "Error: No routes loaded from " << routesFile << endl;
+                }
+            } else {
+                parser.loadRoutesParallel(routesFile, ports, routes);
+            }
+
+            cout << "Total Ports Loaded: " << ports.size() << endl;
+            cout << "Total Routes Loaded: " << routes.size() << endl;
+
+            setStage("Building route network", 70);
+            graph.reservePorts(ports.size());
+            for (int i = 0; i < ports.size(); i++) {
+                graph.addPort(std::move(ports[i]));
+            }
+            cout << "Added " << graph.ports.size() << " ports to graph." << endl;
+
+            // Port names were already resolved to indices by the loader
+            for (int i = 0; i < routes.size(); i++) {
+                graph.addEdgeByIndex(routes[i].originIdx, routes[i].destinationIdx, routes[i].cost, &routes[i]);
+            }
+            cout << "Added edges from " << routes.size() << " routes." << endl;
+
+            // Cache the built graph so the next launch can skip text parsing
+            // (not a failed load, or the snapshot would keep serving it)
+            setStage("Writing graph snapshot", 85);
+            if (routesComplete &&
+                snapshot.write(paths.snapshotFile, paths.portsFile, paths.routesFile, paths.coordinatesFile, graph, routes)) {
+                cout << "Wrote graph snapshot " << paths.snapshotFile << endl;
+            }
+        }
+
+        if (weeklyTimetable) {
+            graph.timetable = TIMETABLE_WEEKLY;
+            cout << "Using weekly recurring timetable" << endl;
+        }
+    }
+};
+
+#endif
@@ -2,9 +2,13 @@
 #define DATASTRUCTS_H
 
 #include <string>
+#include <climits>
+#include <cmath>
 #include "SimpleVector.h"
 #include "SimpleList.h"
 #include "SimpleQueue.h"
+#include "StringInterner.h"
+#include "StringView.h"
 
 using namespace std;
 
@@ -31,38 +35,213 @@ struct Route {
     string company;
     int durationHours;     // Route duration in hours
     int durationMinutes;   // Route duration in minutes (for pathfinding)
+    
+    // Compiled timetable (filled at load time so searches never re-parse text)
+    long long departureDatetime = 0;  // Absolute departure in minutes
+    long long arrivalDatetime = 0;    // Absolute arrival in minutes (overnight-adjusted)
+    
+    // Resolved port indices (-1 if the loader could not match the name)
+    int originIdx = -1;
+    int destinationIdx = -1;
+};
+
+// Proleptic Gregorian calendar arithmetic (days_from_civil / civil_from_days
+// after Howard Hinnant). Loop-free, so loaders can call it per route.
+constexpr bool isLeapYear(int y) {
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+constexpr int daysInMonth(int y, int m) {
+    return m == 2 ? (isLeapYear(y) ? 29 : 28) : 30 + ((m + (m >> 3)) & 1);
+}
+
+// Days since 1970-01-01 (negative before it)
+constexpr long long daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    const long long era = (y >= 0 ? y : y - 399) / 400;
+    const long long yearOfEra = y - era * 400;                                  // [0, 399]
+    const long long dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;  // [0, 365], from March 1
+    const long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+constexpr Date civilFromDays(long long z) {
+    z += 719468;
+    const long long era = (z >= 0 ? z : z - 146096) / 146097;
+    const long long dayOfEra = z - era * 146097;                                // [0, 146096]
+    const long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const long long mp = (5 * dayOfYear + 2) / 153;                             // March = 0
+    const int month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    return {static_cast<int>(dayOfYear - (153 * mp + 2) / 5 + 1), month,
+            static_cast<int>(yearOfEra + era * 400 + (month <= 2))};
+}
+
+static_assert(daysFromCivil(1970, 1, 1) == 0, "calendar epoch");
+static_assert(daysFromCivil(2024, 12, 1) == 20058, "calendar leap years");
+static_assert(civilFromDays(20058).month == 12 && civilFromDays(-1).year == 1969, "calendar inverse");
+
+// Recurring sailings repeat every 7 days
+const long long MINUTES_PER_WEEK = 10080;
+const int NO_WEEK_LIMIT = -1;
+
+enum TimetableMode {
+    TIMETABLE_DATED,   // Each route is a sailing on its own date
+    TIMETABLE_WEEKLY   // Each route repeats every week, in every year
 };
 
+// Shift a sailing by whole weeks to its first repeat departing at or after t
+// (O(1), no stepping). Dated timetables only move forward, by at most
+// maxWeeks; weekly timetables may also move back to an earlier repeat.
+// Returns false if the sailing still departs before t.
+inline bool alignSailing(TimetableMode timetable, long long& departure, long long& arrival, double t, int maxWeeks = NO_WEEK_LIMIT) {
+    long long target = static_cast<long long>(ceil(t));
+    long long behind = target - departure;
+    long long weeks;
+    if (timetable == TIMETABLE_WEEKLY) {
+        weeks = behind / MINUTES_PER_WEEK;
+        if (weeks * MINUTES_PER_WEEK < behind) weeks++;  // Ceiling for either sign
+    } else {
+        if (behind <= 0) return true;
+        weeks = (behind + MINUTES_PER_WEEK - 1) / MINUTES_PER_WEEK;
+        if (maxWeeks != NO_WEEK_LIMIT && weeks > maxWeeks) weeks = maxWeeks;
+    }
+    departure += weeks * MINUTES_PER_WEEK;
+    arrival += weeks * MINUTES_PER_WEEK;
+    return departure >= target;
+}
+
+// Parse a decimal integer from [p, end); false if empty, not all digits or out of int range
+inline bool parseIntChars(const char* p, const char* end, int& out) {
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        p++;
+    }
+    if (p == end) return false;
+    
+    int value = 0;
+    for (; p < end; p++) {
+        unsigned digit = static_cast<unsigned>(*p - '0');
+        if (digit > 9) return false;
+        if (value > (INT_MAX - static_cast<int>(digit)) / 10) return false;
+        value = value * 10 + static_cast<int>(digit);
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+// Parse a decimal like -33.8688 in [p, end)
+inline bool parseDecimalChars(const char* p, const char* end, double& out) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    double value = 0, scale = 1;
+    bool seenDigit = false, seenPoint = false;
+    for (; p < end; p++) {
+        if (*p == '.' && !seenPoint) {
+            seenPoint = true;
+            continue;
+        }
+        unsigned digit = static_cast<unsigned>(*p - '0');
+        if (digit > 9) return false;
+        if (seenPoint) {
+            scale /= 10;
+            value += digit * scale;
+        } else {
+            value = value * 10 + digit;
+        }
+        seenDigit = true;
+    }
+    if (!seenDigit) return false;
+    out = negative ? -value : value;
+    return true;
+}
+
+// Parse "HH:MM" (or "H:MM") from [p, end) to minutes from midnight
+inline bool parseTimeChars(const char* p, const char* end, int& minutes) {
+    const char* colon = p;
+    while (colon < end && *colon != ':') colon++;
+    
+    int h, m;
+    if (colon == end || !parseIntChars(p, colon, h) || !parseIntChars(colon + 1, end, m)) return false;
+    if (h < 0 || h > 23 || m < 0 || m > 59) return false;
+    minutes = h * 60 + m;
+    return true;
+}
+
+// Parse "DD/MM/YYYY" (or "D/M/YYYY") from [p, end)
+inline bool parseDateChars(const char* p, const char* end, Date& d) {
+    const char* firstSlash = p;
+    while (firstSlash < end && *firstSlash != '/') firstSlash++;
+    if (firstSlash == end) return false;
+    const char* secondSlash = firstSlash + 1;
+    while (secondSlash < end && *secondSlash != '/') secondSlash++;
+    if (secondSlash == end) return false;
+    
+    if (!parseIntChars(p, firstSlash, d.day) ||
+        !parseIntChars(firstSlash + 1, secondSlash, d.month) ||
+        !parseIntChars(secondSlash + 1, end, d.year)) return false;
+    return d.month >= 1 && d.month <= 12 && d.day >= 1 && d.day <= daysInMonth(d.year, d.month);
+}
+
 // Parse time string "HH:MM" to minutes from midnight
-inline int timeToMinutes(string timeStr) {
-    int h = stoi(timeStr.substr(0, 2));
-    int m = stoi(timeStr.substr(3, 2));
-    return h * 60 + m;
+inline int timeToMinutes(StringView timeStr) {
+    int minutes = 0;
+    parseTimeChars(timeStr.begin(), timeStr.end(), minutes);
+    return minutes;
 }
 
 // Parse date string "DD/MM/YYYY" or "D/MM/YYYY" to Date struct
-inline Date parseDate(string dateStr) {
-    Date d;
-    size_t firstSlash = dateStr.find('/');
-    size_t secondSlash = dateStr.find('/', firstSlash + 1);
-    
-    d.day = stoi(dateStr.substr(0, firstSlash));
-    d.month = stoi(dateStr.substr(firstSlash + 1, secondSlash - firstSlash - 1));
-    d.year = stoi(dateStr.substr(secondSlash + 1));
+inline Date parseDate(StringView dateStr) {
+    Date d = {0, 0, 0};
+    parseDateChars(dateStr.begin(), dateStr.end(), d);
     return d;
 }
 
-// Convert date and time to total minutes since epoch (Jan 1, 2024)
+// Minutes since 1970-01-01 00:00 for a date and time of day
 inline long long dateTimeToMinutes(Date d, int timeMinutes) {
-    int daysInMonth[] = {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};  // 2024 is leap year
+    return daysFromCivil(d.year, d.month, d.day) * 1440 + timeMinutes;
+}
+
+// Inverse of dateTimeToMinutes
+inline void minutesToDateTime(long long minutes, Date& d, int& timeMinutes) {
+    long long days = minutes / 1440;
+    if (days * 1440 > minutes) days--;  // Round toward earlier days before 1970
+    d = civilFromDays(days);
+    timeMinutes = static_cast<int>(minutes - days * 1440);
+}
+
+// D/M/YYYY, as written in Routes.txt
+inline string formatDate(Date d) {
+    return to_string(d.day) + "/" + to_string(d.month) + "/" + to_string(d.year);
+}
+
+// HH:MM from minutes since midnight
+inline string formatTime(int minutes) {
+    char buffer[6];
+    buffer[0] = static_cast<char>('0' + minutes / 600);
+    buffer[1] = static_cast<char>('0' + minutes / 60 % 10);
+    buffer[2] = ':';
+    buffer[3] = static_cast<char>('0' + minutes % 60 / 10);
+    buffer[4] = static_cast<char>('0' + minutes % 10);
+    buffer[5] = '\0';
+    return string(buffer);
+}
+
+// Fill a route's compiled timetable fields from its parsed date and times
+inline void compileRouteTimes(Route& r, Date depDate, int depTimeMin, int arrTimeMin) {
+    r.departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
+    r.arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
     
-    long long totalDays = 0;
-    for (int m = 1; m < d.month; m++) {
-        totalDays += daysInMonth[m];
+    int diff = arrTimeMin - depTimeMin;
+    if (diff < 0) {
+        diff += 1440;                  // Overnight sailing
+        r.arrivalDatetime += 1440;
     }
-    totalDays += d.day - 1;  // Day 1 = 0 days elapsed
-    
-    return totalDays * 1440 + timeMinutes;  // 1440 minutes per day
+    r.durationMinutes = diff;
 }
 
 // Port node in the graph
@@ -105,49 +284,41 @@ struct Port {
 // Port coordinate lookup (map dimensions: 1050x700)
 struct Point { int x, y; };
 
-inline Point getPortCoordinates(string portName) {
-    if (portName == "Chittagong") return {745, 358};
-    if (portName == "Karachi") return {678, 350};
-    if (portName == "Dublin") return {476, 257};
-    if (portName == "Marseille") return {510, 292};
-    if (portName == "Jeddah") return {604, 359};
-    if (portName == "Colombo") return {714, 402};
-    if (portName == "Sydney") return {907, 521};
-    if (portName == "Melbourne") return {891, 531};
-    if (portName == "Montreal") return {294, 284};
-    if (portName == "Doha") return {635, 349};
-    if (portName == "Manila") return {823, 380};
-    if (portName == "Alexandria") return {575, 332};
-    if (portName == "Istanbul") return {574, 301};
-    if (portName == "Singapore") return {776, 416};
-    if (portName == "Busan") return {848, 318};
-    if (portName == "HongKong") return {804, 357};
-    if (portName == "Durban") return {577, 505};
-    if (portName == "Oslo") return {524, 231};
-    if (portName == "Dubai") return {645, 351};
-    if (portName == "Genoa") return {519, 288};
-    if (portName == "Osaka") return {865, 321};
-    if (portName == "Lisbon") return {469, 307};
-    if (portName == "Hamburg") return {522, 257};
-    if (portName == "Rotterdam") return {510, 258};
-    if (portName == "Helsinki") return {564, 228};
-    if (portName == "Mumbai") return {696, 370};
-    if (portName == "Jakarta") return {787, 434};
-    if (portName == "Tokyo") return {877, 318};
-    if (portName == "Athens") return {558, 309};
-    if (portName == "CapeTown") return {545, 519};
-    if (portName == "Stockholm") return {544, 232};
-    if (portName == "PortLouis") return {658, 485};
-    if (portName == "Shanghai") return {825, 329};
-    if (portName == "NewYork") return {291, 299};
-    if (portName == "AbuDhabi") return {644, 352};
-    if (portName == "Copenhagen") return {528, 249};
-    if (portName == "Vancouver") return {154, 271};
-    if (portName == "LosAngeles") return {168, 323};
-    if (portName == "Antwerp") return {504, 265};
-    if (portName == "London") return {494, 263};
-
-    return {525, 350};  // Default fallback
+// The world map image is a Miller cylindrical projection; these constants
+// place it in the window (fitted to real port coordinates)
+const double MAP_ORIGIN_X = 494.08;  // Pixel x of longitude 0
+const double MAP_SCALE_X = 2.7391;   // Pixels per degree of longitude
+const double MAP_ORIGIN_Y = 421.17;  // Pixel y of the equator
+const double MAP_SCALE_Y = 2.7928;   // Pixels per degree of Miller northing
+
+inline Point projectLatLon(double lat, double lon) {
+    const double toRad = 3.14159265358979323846 / 180.0;
+    // Miller: y = 1.25 * ln(tan(pi/4 + 0.4 * lat)), in degrees
+    double northing = 1.25 * log(tan(0.25 * 3.14159265358979323846 + 0.4 * lat * toRad)) / toRad;
+    return {static_cast<int>(floor(MAP_ORIGIN_X + lon * MAP_SCALE_X + 0.5)),
+            static_cast<int>(floor(MAP_ORIGIN_Y - northing * MAP_SCALE_Y + 0.5))};
 }
 
+// Screen positions of known ports, projected once when PortCoordinates.txt
+// is loaded. Names map to dense ids, ids index a flat array of points.
+struct PortLocator {
+    StringInterner names;
+    SimpleVector<Point> points;
+
+    void add(const char* name, size_t len, double lat, double lon) {
+        int id = names.intern(name, len);
+        if (id == points.size()) {
+            points.push_back(projectLatLon(lat, lon));
+        } else {
+            points[id] = projectLatLon(lat, lon);  // Later entries override
+        }
+    }
+
+    Point locate(const string& portName) const {
+        int id = names.find(portName);
+        if (id == -1) return {525, 350};  // Default fallback
+        return points[id];
+    }
+};
+
 #endif
\ No newline at end of file
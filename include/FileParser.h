@@ -1,71 +1,431 @@
 #ifndef FILEPARSER_H
 #define FILEPARSER_H
 
-#include <fstream>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <thread>
 #include "DataStructs.h"
+#include "MappedFile.h"
+#include "RouteColumns.h"
+#include "StringInterner.h"
 
 using namespace std;
 
+// Collects malformed line numbers while parsing and reports them once at the end
+struct ParseErrorLog {
+    int count = 0;
+    SimpleVector<int> firstLines;  // Only the first few are kept for the report
+
+    void record(int lineNumber) {
+        if (firstLines.size() < 10) {
+            firstLines.push_back(lineNumber);
+        }
+        count++;
+    }
+
+    // Fold in another log whose line numbers start after lineOffset lines
+    void merge(const ParseErrorLog& other, int lineOffset) {
+        for (int i = 0; i < other.firstLines.size(); i++) {
+            record(other.firstLines[i] + lineOffset);
+        }
+        count += other.count - other.firstLines.size();
+    }
+
+    void report(const string& filename) {
+        if (count == 0) return;
+        cout << "Warning: " << filename << ": skipped " << count << " malformed line(s), at line";
+        for (int i = 0; i < firstLines.size(); i++) {
+            cout << (i == 0 ? " " : ", ") << firstLines[i];
+        }
+        if (count > firstLines.size()) cout << ", ...";
+        cout << endl;
+    }
+};
+
+// Whitespace tokenizer over one line of a mapped buffer (no copies)
+struct LineTokens {
+    static const int MAX_TOKENS = 8;
+    const char* begin[MAX_TOKENS];
+    const char* end[MAX_TOKENS];
+    int count;
+
+    // Split [p, lineEnd) on spaces/tabs; stops after MAX_TOKENS tokens
+    void split(const char* p, const char* lineEnd) {
+        count = 0;
+        while (p < lineEnd) {
+            while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+            if (p == lineEnd) break;
+            if (count == MAX_TOKENS) {
+                count++;  // Too many tokens: caller sees count > expected
+                return;
+            }
+            begin[count] = p;
+            while (p < lineEnd && *p != ' ' && *p != '\t' && *p != '\r') p++;
+            end[count] = p;
+            count++;
+        }
+    }
+
+    size_t length(int i) const {
+        return static_cast<size_t>(end[i] - begin[i]);
+    }
+};
+
+// Line parse outcome
+enum LineStatus {
+    LINE_OK,
+    LINE_BLANK,
+    LINE_MALFORMED
+};
+
+// Parse one Routes.txt line: origin dest DD/MM/YYYY HH:MM HH:MM cost company.
+// Strings are assigned straight from the mapped bytes; date, times and cost
+// are decoded in place and compiled into absolute timetable minutes.
+inline LineStatus parseRouteLine(const char* p, const char* lineEnd, Route& r) {
+    LineTokens tok;
+    tok.split(p, lineEnd);
+    if (tok.count == 0) return LINE_BLANK;
+    if (tok.count != 7) return LINE_MALFORMED;
+
+    Date depDate;
+    int depMin, arrMin, cost;
+    if (!parseDateChars(tok.begin[2], tok.end[2], depDate) ||
+        !parseTimeChars(tok.begin[3], tok.end[3], depMin) ||
+        !parseTimeChars(tok.begin[4], tok.end[4], arrMin) ||
+        !parseIntChars(tok.begin[5], tok.end[5], cost)) {
+        return LINE_MALFORMED;
+    }
+
+    r.origin.assign(tok.begin[0], tok.length(0));
+    r.destination.assign(tok.begin[1], tok.length(1));
+    r.departureDate.assign(tok.begin[2], tok.length(2));
+    r.depTime.assign(tok.begin[3], tok.length(3));
+    r.arrTime.assign(tok.begin[4], tok.length(4));
+    r.cost = cost;
+    r.company.assign(tok.begin[6], tok.length(6));
+    compileRouteTimes(r, depDate, depMin, arrMin);
+    return LINE_OK;
+}
+
+// End of the line starting at p (the '\n' or the buffer end)
+inline const char* findLineEnd(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+    return nl ? nl : end;
+}
+
+// One newline-aligned slice of a routes file and the results of parsing it
+struct RouteChunk {
+    const char* begin;
+    const char* end;
+    SimpleVector<Route> routes;
+    ParseErrorLog errors;       // Line numbers local to the chunk
+    int lineCount = 0;
+};
+
 struct FileParser {
-    
+    // Files smaller than this are parsed on the calling thread
+    static const size_t PARALLEL_CHUNK_BYTES = 4 << 20;
+
+    // Screen positions used by loadPorts (see loadPortCoordinates)
+    PortLocator coordinates;
+
+    // Read PortCoordinates.txt lines (name latitude longitude) and project them to the map
+    void loadPortCoordinates(string filename) {
+        MappedFile file;
+        if (!file.open(filename)) {
+            cout << "Error: Could not open " << filename << endl;
+            return;
+        }
+
+        ParseErrorLog errors;
+        const char* p = file.begin();
+        const char* end = file.end();
+        int lineNumber = 0;
+
+        while (p < end) {
+            const char* lineEnd = findLineEnd(p, end);
+            lineNumber++;
+
+            LineTokens tok;
+            tok.split(p, lineEnd);
+            double lat, lon;
+            if (tok.count == 3 &&
+                parseDecimalChars(tok.begin[1], tok.end[1], lat) && lat >= -90 && lat <= 90 &&
+                parseDecimalChars(tok.begin[2], tok.end[2], lon) && lon >= -180 && lon <= 180) {
+                coordinates.add(tok.begin[0], tok.length(0), lat, lon);
+            } else if (tok.count != 0) {
+                errors.record(lineNumber);
+            }
+            p = lineEnd + 1;
+        }
+        errors.report(filename);
+    }
+
     void loadPorts(string filename, SimpleVector<Port>& ports) {
-        ifstream file(filename);
-        if (!file.is_open()) {
+        MappedFile file;
+        if (!file.open(filename)) {
             cout << "Error: Could not open " << filename << endl;
             return;
         }
 
-        string name;
-        int charge;
-        while (file >> name >> charge) {
-            Port p;
-            p.name = name;
-            p.dailyCharge = charge;
-            
-            Point pt = getPortCoordinates(name);
-            p.x = pt.x;
-            p.y = pt.y;
-            
-            ports.push_back(p);
-        }
-        file.close();
+        ParseErrorLog errors;
+        const char* p = file.begin();
+        const char* end = file.end();
+        int lineNumber = 0;
+        int unplaced = 0;
+
+        while (p < end) {
+            const char* lineEnd = findLineEnd(p, end);
+            lineNumber++;
+
+            LineTokens tok;
+            tok.split(p, lineEnd);
+            int charge;
+            if (tok.count == 2 && parseIntChars(tok.begin[1], tok.end[1], charge)) {
+                Port port;
+                port.name.assign(tok.begin[0], tok.length(0));
+                port.dailyCharge = charge;
+
+                Point pt = coordinates.locate(port.name);
+                port.x = pt.x;
+                port.y = pt.y;
+                if (coordinates.names.find(port.name) == -1) unplaced++;
+
+                ports.push_back(std::move(port));
+            } else if (tok.count != 0) {
+                errors.record(lineNumber);
+            }
+            p = lineEnd + 1;
+        }
+        errors.report(filename);
+        if (unplaced > 0) {
+            cout << "Warning: " << unplaced << " port(s) have no coordinates, placed at the map center" << endl;
+        }
     }
 
     void loadRoutes(string filename, SimpleVector<Route>& routes) {
-        ifstream file(filename);
-        if (!file.is_open()) {
+        MappedFile file;
+        if (!file.open(filename)) {
+            cout << "Error: Could not open " << filename << endl;
+            return;
+        }
+
+        ParseErrorLog errors;
+        const char* p = file.begin();
+        const char* end = file.end();
+        int lineNumber = 0;
+        Route r;
+
+        while (p < end) {
+            const char* lineEnd = findLineEnd(p, end);
+            lineNumber++;
+
+            LineStatus status = parseRouteLine(p, lineEnd, r);
+            if (status == LINE_OK) {
+                routes.push_back(r);
+            } else if (status == LINE_MALFORMED) {
+                errors.record(lineNumber);
+            }
+            p = lineEnd + 1;
+        }
+        errors.report(filename);
+    }
+
+    // Parse a routes file on a pool of threads. The mapping is cut into
+    // newline-aligned chunks that workers claim one at a time and parse into
+    // their own buffers; the buffers are then merged in file order.
+    // Origin/destination names are resolved to indices into ports through a
+    // shared interner seeded with the port list.
+    void loadRoutesParallel(string filename, const SimpleVector<Port>& ports, SimpleVector<Route>& routes, int threadCount = 0) {
+        MappedFile file;
+        if (!file.open(filename)) {
             cout << "Error: Could not open " << filename << endl;
             return;
         }
 
-        string origin, dest, date, depT, arrT, company;
-        int cost;
-
-        while (file >> origin >> dest >> date >> depT >> arrT >> cost >> company) {
-            Route r;
-            r.origin = origin;
-            r.destination = dest;
-            r.departureDate = date;
-            r.depTime = depT;
-            r.arrTime = arrT;
-            r.cost = cost;
-            r.company = company;
-            
-            int depMin = timeToMinutes(depT);
-            int arrMin = timeToMinutes(arrT);
-            int diff = arrMin - depMin;
-            
-            if (diff < 0) {
-                diff += 1440;
+        // Seed names with the known ports; any other id means "unknown port"
+        ConcurrentStringInterner names;
+        SimpleVector<int> portOfId;
+        for (int i = 0; i < ports.size(); i++) {
+            int id = names.intern(ports[i].name);
+            while (portOfId.size() <= id) portOfId.push_back(-1);
+            if (portOfId[id] == -1) portOfId[id] = i;  // First match wins, like Graph::getIndex
+        }
+
+        if (threadCount <= 0) {
+            threadCount = static_cast<int>(thread::hardware_concurrency());
+            if (threadCount <= 0) threadCount = 1;
+        }
+
+        // Several chunks per thread so uneven lines still balance out
+        size_t chunkCount = file.length / PARALLEL_CHUNK_BYTES;
+        if (chunkCount > static_cast<size_t>(threadCount) * 4) chunkCount = threadCount * 4;
+        if (chunkCount < 1 || threadCount == 1) chunkCount = 1;
+
+        SimpleVector<RouteChunk> chunks;
+        const char* p = file.begin();
+        for (size_t c = 0; c < chunkCount && p < file.end(); c++) {
+            const char* chunkEnd = file.begin() + file.length * (c + 1) / chunkCount;
+            if (chunkEnd < p) chunkEnd = p;
+            if (chunkEnd < file.end()) chunkEnd = findLineEnd(chunkEnd, file.end());
+            if (chunkEnd < file.end()) chunkEnd++;  // Keep the newline in this chunk
+            RouteChunk chunk;
+            chunk.begin = p;
+            chunk.end = chunkEnd;
+            chunks.push_back(std::move(chunk));
+            p = chunkEnd;
+        }
+
+        atomic<int> nextChunk(0);
+        auto worker = [&]() {
+            // Local name cache: each distinct name touches the shared interner once per worker
+            StringInterner localNames;
+            SimpleVector<int> portOfLocal;
+            auto resolve = [&](const string& name) {
+                int local = localNames.find(name);
+                if (local == -1) {
+                    int id = names.intern(name);
+                    local = localNames.intern(name);
+                    portOfLocal.push_back(id < portOfId.size() ? portOfId[id] : -1);
+                }
+                return portOfLocal[local];
+            };
+
+            int c;
+            while ((c = nextChunk.fetch_add(1)) < chunks.size()) {
+                RouteChunk& chunk = chunks[c];
+                // A single chunk is parsed straight into the caller's store
+                SimpleVector<Route>& out = (chunks.size() == 1) ? routes : chunk.routes;
+                const char* q = chunk.begin;
+                Route r;
+                while (q < chunk.end) {
+                    const char* lineEnd = findLineEnd(q, chunk.end);
+                    chunk.lineCount++;
+
+                    LineStatus status = parseRouteLine(q, lineEnd, r);
+                    if (status == LINE_OK) {
+                        r.originIdx = resolve(r.origin);
+                        r.destinationIdx = resolve(r.destination);
+                        out.push_back(r);
+                    } else if (status == LINE_MALFORMED) {
+                        chunk.errors.record(chunk.lineCount);
+                    }
+                    q = lineEnd + 1;
+                }
+            }
+        };
+
+        int workerCount = threadCount < chunks.size() ? threadCount : chunks.size();
+        SimpleVector<thread*> pool;
+        for (int t = 1; t < workerCount; t++) {
+            pool.push_back(new thread(worker));
+        }
+        worker();  // The calling thread works too
+        for (int t = 0; t < pool.size(); t++) {
+            pool[t]->join();
+            delete pool[t];
+        }
+
+        // Merge per-chunk buffers in file order, moving the routes across
+        if (chunks.size() > 1) {
+            int total = routes.size();
+            for (int c = 0; c < chunks.size(); c++) {
+                total += chunks[c].routes.size();
+            }
+            routes.reserve(total);
+        }
+        ParseErrorLog errors;
+        int lineOffset = 0;
+        for (int c = 0; c < chunks.size(); c++) {
+            RouteChunk& chunk = chunks[c];
+            for (int i = 0; chunks.size() > 1 && i < chunk.routes.size(); i++) {
+                routes.push_back(std::move(chunk.routes[i]));
+            }
+            chunk.routes = SimpleVector<Route>();  // Free the chunk buffer as soon as it is merged
+            errors.merge(chunk.errors, lineOffset);
+            lineOffset += chunk.lineCount;
+        }
+        errors.report(filename);
+    }
+
+    // Load a columnar route file (see RouteColumns.h). Names come from the
+    // file's dictionaries, which are resolved to port indices once up front;
+    // date and time strings are regenerated from the minute columns.
+    // All or nothing: returns false, leaving routes as it was, if the file
+    // is missing or any row is truncated or corrupt.
+    bool loadRoutesColumnar(string filename, const SimpleVector<Port>& ports, SimpleVector<Route>& routes) {
+        RouteColumnsFile columns;
+        if (!columns.open(filename)) {
+            cout << "Error: Could not open " << filename << endl;
+            return false;
+        }
+
+        StringInterner portNames;
+        SimpleVector<int> portOfName;
+        for (int i = 0; i < ports.size(); i++) {
+            if (portNames.intern(ports[i].name) == portOfName.size()) {
+                portOfName.push_back(i);  // First match wins, like Graph::getIndex
             }
-            r.durationMinutes = diff;
-            
+        }
+        SimpleVector<int> portOfDictionary;
+        for (int i = 0; i < columns.portNames.size(); i++) {
+            int id = portNames.find(columns.portNames[i]);
+            portOfDictionary.push_back(id == -1 ? -1 : portOfName[id]);
+        }
+
+        ColumnReader readers[ROUTE_COLUMN_COUNT];
+        for (int c = 0; c < ROUTE_COLUMN_COUNT; c++) {
+            readers[c] = columns.column(static_cast<RouteColumn>(c));
+        }
+
+        int portCount = columns.portNames.size();
+        int companyCount = columns.companyNames.size();
+        int firstRow = routes.size();
+        routes.reserve(firstRow + columns.rowCount());
+        Route r;
+        for (int row = 0; row < columns.rowCount(); row++) {
+            int64_t v[ROUTE_COLUMN_COUNT];
+            for (int c = 0; c < ROUTE_COLUMN_COUNT; c++) {
+                if (!readers[c].next(v[c])) {
+                    cout << "Error: " << filename << ": column " << c << " ends at row " << row << endl;
+                    routes.resize(firstRow);
+                    return false;
+                }
+            }
+            if (v[COLUMN_ORIGIN] < 0 || v[COLUMN_ORIGIN] >= portCount ||
+                v[COLUMN_DESTINATION] < 0 || v[COLUMN_DESTINATION] >= portCount ||
+                v[COLUMN_COMPANY] < 0 || v[COLUMN_COMPANY] >= companyCount ||
+                v[COLUMN_ARRIVAL] < v[COLUMN_DEPARTURE]) {
+                cout << "Error: " << filename << ": corrupt values at row " << row << endl;
+                routes.resize(firstRow);
+                return false;
+            }
+
+            Date depDate;
+            int depMin;
+            minutesToDateTime(v[COLUMN_DEPARTURE], depDate, depMin);
+
+            r.origin = columns.portNames[v[COLUMN_ORIGIN]];
+            r.destination = columns.portNames[v[COLUMN_DESTINATION]];
+            r.departureDate = formatDate(depDate);
+            r.depTime = formatTime(depMin);
+            Date arrDate;
+            int arrMin;
+            minutesToDateTime(v[COLUMN_ARRIVAL], arrDate, arrMin);
+            r.arrTime = formatTime(arrMin);
+            r.cost = static_cast<int>(v[COLUMN_COST]);
+            r.company = columns.companyNames[v[COLUMN_COMPANY]];
+            r.departureDatetime = v[COLUMN_DEPARTURE];
+            r.arrivalDatetime = v[COLUMN_ARRIVAL];
+            r.durationMinutes = static_cast<int>(v[COLUMN_ARRIVAL] - v[COLUMN_DEPARTURE]);
+            r.originIdx = portOfDictionary[v[COLUMN_ORIGIN]];
+            r.destinationIdx = portOfDictionary[v[COLUMN_DESTINATION]];
             routes.push_back(r);
         }
-        file.close();
+        return true;
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -7,6 +7,7 @@
 #include <ctime>
 #include "SimpleVector.h"
 #include "SimpleList.h"
+#include "SimpleHashMap.h"
 #include "DataStructs.h"
 
 using namespace std;
@@ -22,23 +23,36 @@ struct Edge {
 struct Graph {
     SimpleVector<Port> ports;
     SimpleVector<SimpleList<Edge>> adjList;
+    SimpleHashMap<string, int> portIndex;  // Name -> index of the first port with that name
+    int version = 0;  // Bumped whenever edges change after the initial build
 
-    int getIndex(string portName) {
-        for (int i = 0; i < ports.size(); i++) {
-            if (ports[i].name == portName) {
-                return i;
-            }
-        }
-        return -1;
+    // departureDayRange() result, valid while version and port count match
+    int dayRangeVersion = -1;
+    int dayRangePorts = -1;
+    long long dayRangeFirst = 0;
+    long long dayRangeLast = -1;
+    bool dayRangeFound = false;
+    TimetableMode timetable = TIMETABLE_DATED;
+
+    int getIndex(StringView portName) const {
+        const int* index = portIndex.find(portName);
+        return index != nullptr ? *index : -1;
+    }
+
+    // Room for n ports without regrowing the port and adjacency arrays
+    void reservePorts(int n) {
+        ports.reserve(n);
+        adjList.reserve(n);
+        portIndex.reserve(n);
     }
 
     void addPort(Port p) {
-        ports.push_back(p);
-        SimpleList<Edge> emptyList;
-        adjList.push_back(emptyList);
+        portIndex.insert(p.name, ports.size());
+        ports.push_back(std::move(p));
+        adjList.emplace_back();
     }
 
-    void addEdge(string originName, string destName, int cost, Route* routePtr) {
+    void addEdge(StringView originName, StringView destName, int cost, Route* routePtr) {
         int u = getIndex(originName);
         int v = getIndex(destName);
         
@@ -48,6 +62,72 @@ struct Graph {
         }
     }
 
+    // Add an edge between already-resolved port indices (no name lookups)
+    void addEdgeByIndex(int u, int v, int cost, Route* routePtr) {
+        if (u >= 0 && u < ports.size() && v >= 0 && v < ports.size()) {
+            adjList[u].push_back(Edge(v, cost, routePtr));
+        }
+    }
+
+    // First and last day (days since 1970-01-01) with a departure; false if there are no edges
+    bool departureDayRange(long long& firstDay, long long& lastDay) {
+        if (dayRangeVersion == version && dayRangePorts == ports.size()) {
+            firstDay = dayRangeFirst;
+            lastDay = dayRangeLast;
+            return dayRangeFound;
+        }
+        bool found = false;
+        for (int u = 0; u < ports.size(); u++) {
+            Node<Edge>* current = adjList[u].head;
+            while (current != nullptr) {
+                long long minutes = current->data.routeData->departureDatetime;
+                long long day = minutes / 1440;
+                if (day * 1440 > minutes) day--;
+                if (!found || day < firstDay) firstDay = day;
+                if (!found || day > lastDay) lastDay = day;
+                found = true;
+                current = current->next;
+            }
+        }
+        dayRangeVersion = version;
+        dayRangePorts = ports.size();
+        dayRangeFirst = firstDay;
+        dayRangeLast = lastDay;
+        dayRangeFound = found;
+        return found;
+    }
+
+    // Edge u -> v operated by the given departure and company, or nullptr
+    Edge* findEdge(int u, int v, long long departureDatetime, const string& company) {
+        if (u < 0 || u >= ports.size()) return nullptr;
+        Node<Edge>* current = adjList[u].head;
+        while (current != nullptr) {
+            Route* r = current->data.routeData;
+            if (current->data.destinationPortIndex == v && r->departureDatetime == departureDatetime && r->company == company) {
+                return &current->data;
+            }
+            current = current->next;
+        }
+        return nullptr;
+    }
+
+    // Unlink the edge out of u that carries the given route
+    bool removeEdge(int u, Route* routePtr) {
+        if (u < 0 || u >= ports.size()) return false;
+        SimpleList<Edge>& list = adjList[u];
+        Node<Edge>* prev = nullptr;
+        Node<Edge>* current = list.head;
+        while (current != nullptr) {
+            if (current->data.routeData == routePtr) {
+                list.erase(prev, current);
+                return true;
+            }
+            prev = current;
+            current = current->next;
+        }
+        return false;
+    }
+
     void displayGraph() {
         for (int i = 0; i < ports.size(); i++) {
             cout << "Port [" << ports[i].name << "] connects to:";
@@ -0,0 +1,392 @@
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "SimpleVector.h"
+#include "DataStructs.h"
+#include "Graph.h"
+#include "MappedFile.h"
+#include "StringInterner.h"
+
+using namespace std;
+
+// Binary snapshot of a built Graph, written once after a text load and
+// memory-mapped on later launches. Every section is a flat array of
+// fixed-size records at an 8-byte aligned offset, so loading is a bounds
+// check plus direct indexing - no tokenizing and no name lookups.
+//
+// Layout: [header][string offsets][string bytes][ports][routes]
+//         [CSR row starts][CSR edges][departure col][arrival col][duration col]
+
+const char SNAPSHOT_MAGIC[8] = {'O', 'R', 'N', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SNAPSHOT_VERSION = 3;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+
+    // Source text files the snapshot was built from (staleness check)
+    int64_t portsFileSize;
+    int64_t portsFileModified;
+    int64_t routesFileSize;
+    int64_t routesFileModified;
+    int64_t coordinatesFileSize;
+    int64_t coordinatesFileModified;
+
+    uint32_t portCount;
+    uint32_t routeCount;
+    uint32_t edgeCount;
+    uint32_t stringCount;
+    uint64_t stringBytes;
+
+    uint64_t stringOffsetsOffset;   // uint32[stringCount + 1]
+    uint64_t stringDataOffset;      // char[stringBytes], each string NUL-terminated
+    uint64_t portsOffset;           // SnapshotPort[portCount]
+    uint64_t routesOffset;          // SnapshotRoute[routeCount]
+    uint64_t rowStartOffset;        // uint32[portCount + 1]
+    uint64_t edgesOffset;           // SnapshotEdge[edgeCount]
+    uint64_t departureOffset;       // int64[routeCount], departure minute since 1970-01-01
+    uint64_t arrivalOffset;         // int64[routeCount], arrival minute since 1970-01-01
+    uint64_t durationOffset;        // int32[routeCount], sailing minutes
+    uint64_t fileSize;
+};
+
+struct SnapshotPort {
+    uint32_t nameId;
+    int32_t dailyCharge;
+    int32_t x, y;
+};
+
+struct SnapshotRoute {
+    uint32_t originId;
+    uint32_t destinationId;
+    uint32_t dateId;
+    uint32_t depTimeId;
+    uint32_t arrTimeId;
+    uint32_t companyId;
+    int32_t cost;
+    int32_t reserved;
+};
+
+struct SnapshotEdge {
+    int32_t destination;
+    int32_t weight;
+    uint32_t routeIndex;
+    uint32_t reserved;
+};
+
+struct GraphSnapshot {
+
+    static uint64_t alignUp(uint64_t offset) {
+        return (offset + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    // Write the graph (and the route store its edges point into) to path
+    bool write(string path, string portsFile, string routesFile, string coordinatesFile, Graph& graph, SimpleVector<Route>& routes) {
+        FileStamp portsStamp, routesStamp, coordinatesStamp;
+        if (!getFileStamp(portsFile, portsStamp) || !getFileStamp(routesFile, routesStamp) ||
+            !getFileStamp(coordinatesFile, coordinatesStamp)) {
+            cout << "Error: Could not stat source files for snapshot" << endl;
+            return false;
+        }
+
+        int portCount = graph.ports.size();
+        int routeCount = routes.size();
+
+        // Intern every string once; records refer to them by id
+        StringInterner strings;
+        SimpleVector<SnapshotPort> portRecords;
+        for (int i = 0; i < portCount; i++) {
+            Port& p = graph.ports[i];
+            SnapshotPort rec;
+            rec.nameId = strings.intern(p.name);
+            rec.dailyCharge = p.dailyCharge;
+            rec.x = p.x;
+            rec.y = p.y;
+            portRecords.push_back(rec);
+        }
+
+        SimpleVector<SnapshotRoute> routeRecords;
+        SimpleVector<int64_t> departures;
+        SimpleVector<int64_t> arrivals;
+        SimpleVector<int32_t> durations;
+        for (int i = 0; i < routeCount; i++) {
+            Route& r = routes[i];
+            SnapshotRoute rec;
+            rec.originId = strings.intern(r.origin);
+            rec.destinationId = strings.intern(r.destination);
+            rec.dateId = strings.intern(r.departureDate);
+            rec.depTimeId = strings.intern(r.depTime);
+            rec.arrTimeId = strings.intern(r.arrTime);
+            rec.companyId = strings.intern(r.company);
+            rec.cost = r.cost;
+            rec.reserved = 0;
+            routeRecords.push_back(rec);
+
+            departures.push_back(r.departureDatetime);
+            arrivals.push_back(r.arrivalDatetime);
+            durations.push_back(r.durationMinutes);
+        }
+
+        // Flatten adjacency lists into CSR form
+        SimpleVector<uint32_t> rowStart;
+        SimpleVector<SnapshotEdge> edgeRecords;
+        for (int u = 0; u < portCount; u++) {
+            rowStart.push_back(static_cast<uint32_t>(edgeRecords.size()));
+            Node<Edge>* current = graph.adjList[u].head;
+            while (current != nullptr) {
+                SnapshotEdge rec;
+                rec.destination = current->data.destinationPortIndex;
+                rec.weight = current->data.weight;
+                rec.routeIndex = static_cast<uint32_t>(current->data.routeData - &routes[0]);
+                rec.reserved = 0;
+                edgeRecords.push_back(rec);
+                current = current->next;
+            }
+        }
+        rowStart.push_back(static_cast<uint32_t>(edgeRecords.size()));
+
+        SimpleVector<uint32_t> stringOffsets;
+        uint64_t stringBytes = 0;
+        for (int i = 0; i < strings.size(); i++) {
+            stringOffsets.push_back(static_cast<uint32_t>(stringBytes));
+            stringBytes += strings.get(i).size() + 1;
+        }
+        stringOffsets.push_back(static_cast<uint32_t>(stringBytes));
+
+        SnapshotHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.headerSize = sizeof(SnapshotHeader);
+        header.portsFileSize = portsStamp.size;
+        header.portsFileModified = portsStamp.modified;
+        header.routesFileSize = routesStamp.size;
+        header.routesFileModified = routesStamp.modified;
+        header.coordinatesFileSize = coordinatesStamp.size;
+        header.coordinatesFileModified = coordinatesStamp.modified;
+        header.portCount = portCount;
+        header.routeCount = routeCount;
+        header.edgeCount = edgeRecords.size();
+        header.stringCount = strings.size();
+        header.stringBytes = stringBytes;
+
+        uint64_t offset = alignUp(sizeof(SnapshotHeader));
+        header.stringOffsetsOffset = offset;
+        offset = alignUp(offset + sizeof(uint32_t) * (strings.size() + 1));
+        header.stringDataOffset = offset;
+        offset = alignUp(offset + stringBytes);
+        header.portsOffset = offset;
+        offset = alignUp(offset + sizeof(SnapshotPort) * portCount);
+        header.routesOffset = offset;
+        offset = alignUp(offset + sizeof(SnapshotRoute) * routeCount);
+        header.rowStartOffset = offset;
+        offset = alignUp(offset + sizeof(uint32_t) * (portCount + 1));
+        header.edgesOffset = offset;
+        offset = alignUp(offset + sizeof(SnapshotEdge) * edgeRecords.size());
+        header.departureOffset = offset;
+        offset = alignUp(offset + sizeof(int64_t) * routeCount);
+        header.arrivalOffset = offset;
+        offset = alignUp(offset + sizeof(int64_t) * routeCount);
+        header.durationOffset = offset;
+        offset = alignUp(offset + sizeof(int32_t) * routeCount);
+        header.fileSize = offset;
+
+        // Write to a temp file and rename, so a crash never leaves a torn snapshot
+        string tempPath = path + ".tmp";
+        ofstream file(tempPath, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            cout << "Error: Could not write snapshot " << tempPath << endl;
+            return false;
+        }
+
+        uint64_t written = 0;
+        auto writeSection = [&](uint64_t sectionOffset, const void* bytes, uint64_t count) {
+            static const char padding[8] = {0};
+            while (written < sectionOffset) {
+                uint64_t pad = sectionOffset - written;
+                if (pad > 8) pad = 8;
+                file.write(padding, pad);
+                written += pad;
+            }
+            if (count > 0) {
+                file.write(static_cast<const char*>(bytes), count);
+                written += count;
+            }
+        };
+
+        writeSection(0, &header, sizeof(header));
+        writeSection(header.stringOffsetsOffset, &stringOffsets[0], sizeof(uint32_t) * stringOffsets.size());
+        writeSection(header.stringDataOffset, nullptr, 0);
+        for (int i = 0; i < strings.size(); i++) {
+            const string& s = strings.get(i);
+            writeSection(written, s.c_str(), s.size() + 1);
+        }
+        writeSection(header.portsOffset, portCount ? &portRecords[0] : nullptr, sizeof(SnapshotPort) * portCount);
+        writeSection(header.routesOffset, routeCount ? &routeRecords[0] : nullptr, sizeof(SnapshotRoute) * routeCount);
+        writeSection(header.rowStartOffset, &rowStart[0], sizeof(uint32_t) * rowStart.size());
+        writeSection(header.edgesOffset, edgeRecords.size() ? &edgeRecords[0] : nullptr, sizeof(SnapshotEdge) * edgeRecords.size());
+        writeSection(header.departureOffset, routeCount ? &departures[0] : nullptr, sizeof(int64_t) * routeCount);
+        writeSection(header.arrivalOffset, routeCount ? &arrivals[0] : nullptr, sizeof(int64_t) * routeCount);
+        writeSection(header.durationOffset, routeCount ? &durations[0] : nullptr, sizeof(int32_t) * routeCount);
+        writeSection(header.fileSize, nullptr, 0);
+
+        file.close();
+        if (!file) {
+            cout << "Error: Failed writing snapshot " << tempPath << endl;
+            remove(tempPath.c_str());
+            return false;
+        }
+        remove(path.c_str());
+        if (rename(tempPath.c_str(), path.c_str()) != 0) {
+            cout << "Error: Could not move snapshot into place at " << path << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // True if the snapshot exists and matches the current text sources.
+    // Missing text sources are not an error: the snapshot is then authoritative.
+    bool isFresh(const SnapshotHeader& header, string portsFile, string routesFile, string coordinatesFile) {
+        FileStamp stamp;
+        if (getFileStamp(portsFile, stamp)) {
+            if (stamp.size != header.portsFileSize || stamp.modified != header.portsFileModified) return false;
+        }
+        if (getFileStamp(routesFile, stamp)) {
+            if (stamp.size != header.routesFileSize || stamp.modified != header.routesFileModified) return false;
+        }
+        if (getFileStamp(coordinatesFile, stamp)) {
+            if (stamp.size != header.coordinatesFileSize || stamp.modified != header.coordinatesFileModified) return false;
+        }
+        return true;
+    }
+
+    // Map the snapshot and rebuild graph + routes from it.
+    // Returns false (leaving both untouched) if it is missing, stale or corrupt.
+    // Graph and routes must be empty: snapshot indices are stored from zero.
+    bool load(string path, string portsFile, string routesFile, string coordinatesFile, Graph& graph, SimpleVector<Route>& routes) {
+        if (graph.ports.size() != 0 || routes.size() != 0) {
+            cout << "Error: Snapshot can only be loaded into an empty graph" << endl;
+            return false;
+        }
+        MappedFile file;
+        if (!file.open(path)) return false;
+        if (file.length < sizeof(SnapshotHeader)) return false;
+
+        const SnapshotHeader& header = *reinterpret_cast<const SnapshotHeader*>(file.data);
+        if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != SNAPSHOT_VERSION ||
+            header.headerSize != sizeof(SnapshotHeader) ||
+            header.fileSize != file.length) {
+            cout << "Snapshot " << path << " has an unknown format, ignoring it." << endl;
+            return false;
+        }
+        if (!isFresh(header, portsFile, routesFile, coordinatesFile)) {
+            cout << "Snapshot " << path << " is stale, falling back to text files." << endl;
+            return false;
+        }
+
+        auto sectionFits = [&](uint64_t offset, uint64_t bytes) {
+            return offset % 8 == 0 && offset <= file.length && bytes <= file.length - offset;
+        };
+        if (!sectionFits(header.stringOffsetsOffset, sizeof(uint32_t) * (uint64_t(header.stringCount) + 1)) ||
+            !sectionFits(header.stringDataOffset, header.stringBytes) ||
+            !sectionFits(header.portsOffset, sizeof(SnapshotPort) * uint64_t(header.portCount)) ||
+            !sectionFits(header.routesOffset, sizeof(SnapshotRoute) * uint64_t(header.routeCount)) ||
+            !sectionFits(header.rowStartOffset, sizeof(uint32_t) * (uint64_t(header.portCount) + 1)) ||
+            !sectionFits(header.edgesOffset, sizeof(SnapshotEdge) * uint64_t(header.edgeCount)) ||
+            !sectionFits(header.departureOffset, sizeof(int64_t) * uint64_t(header.routeCount)) ||
+            !sectionFits(header.arrivalOffset, sizeof(int64_t) * uint64_t(header.routeCount)) ||
+            !sectionFits(header.durationOffset, sizeof(int32_t) * uint64_t(header.routeCount))) {
+            cout << "Snapshot " << path << " is truncated or corrupt, ignoring it." << endl;
+            return false;
+        }
+
+        const char* base = file.data;
+        const uint32_t* stringOffsets = reinterpret_cast<const uint32_t*>(base + header.stringOffsetsOffset);
+        const char* stringData = base + header.stringDataOffset;
+        const SnapshotPort* portRecords = reinterpret_cast<const SnapshotPort*>(base + header.portsOffset);
+        const SnapshotRoute* routeRecords = reinterpret_cast<const SnapshotRoute*>(base + header.routesOffset);
+        const uint32_t* rowStart = reinterpret_cast<const uint32_t*>(base + header.rowStartOffset);
+        const SnapshotEdge* edgeRecords = reinterpret_cast<const SnapshotEdge*>(base + header.edgesOffset);
+        const int64_t* departures = reinterpret_cast<const int64_t*>(base + header.departureOffset);
+        const int64_t* arrivals = reinterpret_cast<const int64_t*>(base + header.arrivalOffset);
+        const int32_t* durations = reinterpret_cast<const int32_t*>(base + header.durationOffset);
+
+        // Validate every index before touching the graph
+        auto indicesValid = [&]() {
+            for (uint32_t i = 0; i < header.stringCount; i++) {
+                if (stringOffsets[i] >= stringOffsets[i + 1] || stringOffsets[i + 1] > header.stringBytes) return false;
+            }
+            for (uint32_t i = 0; i < header.portCount; i++) {
+                if (portRecords[i].nameId >= header.stringCount) return false;
+            }
+            for (uint32_t i = 0; i < header.routeCount; i++) {
+                const SnapshotRoute& r = routeRecords[i];
+                if (r.originId >= header.stringCount || r.destinationId >= header.stringCount ||
+                    r.dateId >= header.stringCount || r.depTimeId >= header.stringCount ||
+                    r.arrTimeId >= header.stringCount || r.companyId >= header.stringCount) return false;
+            }
+            if (rowStart[0] != 0 || rowStart[header.portCount] != header.edgeCount) return false;
+            for (uint32_t u = 0; u < header.portCount; u++) {
+                if (rowStart[u] > rowStart[u + 1]) return false;
+            }
+            for (uint32_t e = 0; e < header.edgeCount; e++) {
+                if (edgeRecords[e].destination < 0 || uint32_t(edgeRecords[e].destination) >= header.portCount ||
+                    edgeRecords[e].routeIndex >= header.routeCount) return false;
+            }
+            return true;
+        };
+        if (!indicesValid()) {
+            cout << "Snapshot " << path << " is corrupt, reparsing the text files." << endl;
+            return false;
+        }
+
+        auto stringAt = [&](uint32_t id) {
+            return string(stringData + stringOffsets[id], stringOffsets[id + 1] - stringOffsets[id] - 1);
+        };
+
+        // Routes first: edges hold pointers into this store, so it must not grow afterwards
+        routes.reserve(header.routeCount);
+        for (uint32_t i = 0; i < header.routeCount; i++) {
+            const SnapshotRoute& rec = routeRecords[i];
+            Route r;
+            r.origin = stringAt(rec.originId);
+            r.destination = stringAt(rec.destinationId);
+            r.departureDate = stringAt(rec.dateId);
+            r.depTime = stringAt(rec.depTimeId);
+            r.arrTime = stringAt(rec.arrTimeId);
+            r.company = stringAt(rec.companyId);
+            r.cost = rec.cost;
+            r.durationMinutes = durations[i];
+            r.departureDatetime = departures[i];
+            r.arrivalDatetime = arrivals[i];
+            routes.push_back(std::move(r));
+        }
+
+        graph.reservePorts(header.portCount);
+        for (uint32_t i = 0; i < header.portCount; i++) {
+            const SnapshotPort& rec = portRecords[i];
+            graph.addPort(Port(stringAt(rec.nameId), rec.dailyCharge, rec.x, rec.y));
+        }
+
+        for (uint32_t u = 0; u < header.portCount; u++) {
+            for (uint32_t e = rowStart[u]; e < rowStart[u + 1]; e++) {
+                const SnapshotEdge& rec = edgeRecords[e];
+                Route& route = routes[rec.routeIndex];
+                route.originIdx = u;
+                route.destinationIdx = rec.destination;
+                graph.addEdgeByIndex(u, rec.destination, rec.weight, &route);
+            }
+        }
+        return true;
+    }
+};
+
+#endif
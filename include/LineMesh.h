@@ -0,0 +1,90 @@
+#ifndef LINEMESH_H
+#define LINEMESH_H
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+
+// Thick lines as triangles, appended to an sf::Triangles vertex array so
+// any number of lines of any width go out in one draw call.
+
+// Joins sharper than this (miter length / half width) are bevelled
+const float LINE_MITER_LIMIT = 4.0f;
+
+// Unit normal (left side) of a->b, or (0,0) for a zero-length segment
+inline sf::Vector2f lineNormal(sf::Vector2f a, sf::Vector2f b) {
+    sf::Vector2f d = b - a;
+    float len = std::sqrt(d.x * d.x + d.y * d.y);
+    if (len <= 0.0f) return sf::Vector2f(0.0f, 0.0f);
+    return sf::Vector2f(-d.y / len, d.x / len);
+}
+
+// Quad a0-a1-b1-b0 as two triangles
+inline void appendQuad(sf::VertexArray& out, sf::Vector2f a0, sf::Vector2f a1, sf::Vector2f b0, sf::Vector2f b1, sf::Color color) {
+    out.append(sf::Vertex(a0, color));
+    out.append(sf::Vertex(a1, color));
+    out.append(sf::Vertex(b1, color));
+    out.append(sf::Vertex(a0, color));
+    out.append(sf::Vertex(b1, color));
+    out.append(sf::Vertex(b0, color));
+}
+
+inline void appendThickLine(sf::VertexArray& out, sf::Vector2f a, sf::Vector2f b, float width, sf::Color color) {
+    sf::Vector2f offset = lineNormal(a, b) * (width * 0.5f);
+    if (offset.x == 0.0f && offset.y == 0.0f) return;
+    appendQuad(out, a + offset, a - offset, b + offset, b - offset, color);
+}
+
+// Polyline through points[0..count) with mitred joins (bevelled past
+// LINE_MITER_LIMIT). Repeated points are skipped.
+inline void appendPolyline(sf::VertexArray& out, const sf::Vector2f* points, int count, float width, sf::Color color) {
+    float half = width * 0.5f;
+    sf::Vector2f prevLeft, prevRight;  // Where the previous segment's quad ends
+    sf::Vector2f prevNormal;
+    int prev = -1;                     // Index of the last distinct point
+
+    for (int i = 0; i < count; i++) {
+        if (prev == -1) {
+            prev = i;
+            continue;
+        }
+        sf::Vector2f normal = lineNormal(points[prev], points[i]);
+        if (normal.x == 0.0f && normal.y == 0.0f) continue;
+
+        sf::Vector2f startLeft = points[prev] + normal * half;
+        sf::Vector2f startRight = points[prev] - normal * half;
+        if (prevNormal.x != 0.0f || prevNormal.y != 0.0f) {
+            // Join at points[prev] between the previous segment and this one
+            sf::Vector2f miter = prevNormal + normal;
+            float miterLen = std::sqrt(miter.x * miter.x + miter.y * miter.y);
+            float cosHalf = miterLen > 0.0f ? (miter.x * normal.x + miter.y * normal.y) / miterLen : 0.0f;
+            if (cosHalf > 1.0f / LINE_MITER_LIMIT) {
+                sf::Vector2f offset = miter * (half / (miterLen * cosHalf));
+                startLeft = points[prev] + offset;
+                startRight = points[prev] - offset;
+                // Stretch the previous quad's end to the shared miter corners
+                int n = static_cast<int>(out.getVertexCount());
+                out[n - 4].position = startRight;
+                out[n - 2].position = startRight;
+                out[n - 1].position = startLeft;
+            } else {
+                // Bevel: fill the wedge on both sides (the inner one is covered anyway)
+                out.append(sf::Vertex(points[prev], color));
+                out.append(sf::Vertex(prevLeft, color));
+                out.append(sf::Vertex(startLeft, color));
+                out.append(sf::Vertex(points[prev], color));
+                out.append(sf::Vertex(prevRight, color));
+                out.append(sf::Vertex(startRight, color));
+            }
+        }
+
+        sf::Vector2f endLeft = points[i] + normal * half;
+        sf::Vector2f endRight = points[i] - normal * half;
+        appendQuad(out, startLeft, startRight, endLeft, endRight, color);
+        prevLeft = endLeft;
+        prevRight = endRight;
+        prevNormal = normal;
+        prev = i;
+    }
+}
+
+#endif
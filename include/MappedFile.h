@@ -0,0 +1,119 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <cstdio>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Read-only view of a whole file. Uses mmap on POSIX systems and falls
+// back to reading the file into a heap buffer elsewhere.
+struct MappedFile {
+    const char* data;
+    size_t length;
+    bool isOpen;
+    bool isMapped;
+
+    MappedFile() : data(nullptr), length(0), isOpen(false), isMapped(false) {}
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    bool open(const string& filename) {
+        close();
+#ifdef _WIN32
+        FILE* f = fopen(filename.c_str(), "rb");
+        if (f == nullptr) return false;
+        fseek(f, 0, SEEK_END);
+        long size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        if (size < 0) {
+            fclose(f);
+            return false;
+        }
+        char* buffer = new char[size > 0 ? size : 1];
+        if (size > 0 && fread(buffer, 1, size, f) != static_cast<size_t>(size)) {
+            delete[] buffer;
+            fclose(f);
+            return false;
+        }
+        fclose(f);
+        data = buffer;
+        length = static_cast<size_t>(size);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            madvise(p, length, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(p);
+            isMapped = true;
+        }
+        ::close(fd);
+#endif
+        isOpen = true;
+        return true;
+    }
+
+    void close() {
+        if (data != nullptr) {
+#ifdef _WIN32
+            delete[] data;
+#else
+            if (isMapped) munmap(const_cast<char*>(data), length);
+#endif
+        }
+        data = nullptr;
+        length = 0;
+        isOpen = false;
+        isMapped = false;
+    }
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+};
+
+// Size and modification time of a file (for staleness checks)
+struct FileStamp {
+    long long size;
+    long long modified;
+};
+
+inline bool getFileStamp(const string& filename, FileStamp& out) {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(filename.c_str(), &st) != 0) return false;
+#else
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) return false;
+#endif
+    out.size = static_cast<long long>(st.st_size);
+    out.modified = static_cast<long long>(st.st_mtime);
+    return true;
+}
+
+#endif
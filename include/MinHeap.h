@@ -1,74 +1,103 @@
 #ifndef MINHEAP_H
 #define MINHEAP_H
 
+#include <utility>
 #include "SimpleVector.h"
 
-template <typename T>
+// Min-heap where every node has up to Arity children (2 = binary heap).
+// Sifting moves a hole through the tree and writes the element once at
+// its final slot, instead of swapping it through a temporary per level.
+template <typename T, int Arity = 2>
 struct MinHeap {
+    static_assert(Arity >= 2, "MinHeap needs at least two children per node");
+
     SimpleVector<T> heap;
 
-    int parent(int i) { return (i - 1) / 2; }
-    int left(int i) { return (2 * i) + 1; }
-    int right(int i) { return (2 * i) + 2; }
+    MinHeap() {}
+    explicit MinHeap(Arena* a) : heap(a) {}
+
+    static int parent(int i) { return (i - 1) / Arity; }
+    static int firstChild(int i) { return Arity * i + 1; }
+
+    void reserve(int n) {
+        heap.reserve(n);
+    }
 
-    void push(T val) {
+    void push(const T& val) {
         heap.push_back(val);
-        int index = heap.size() - 1;
-        bubbleUp(index);
+        siftUp(heap.size() - 1);
+    }
+
+    void push(T&& val) {
+        heap.push_back(std::move(val));
+        siftUp(heap.size() - 1);
     }
 
     void pop() {
         if (heap.size() == 0) return;
-        heap[0] = heap[heap.size() - 1];
-        heap.pop_back();
-        if (heap.size() > 0) {
-            bubbleDown(0);
+        if (heap.size() == 1) {
+            heap.pop_back();
+            return;
         }
+        T last = std::move(heap[heap.size() - 1]);
+        heap.pop_back();
+        siftDown(0, std::move(last));
     }
 
-    T top() {
-        if (heap.size() > 0) return heap[0];
-        return T();
+    // Same as push(val) followed by taking and popping the top, in one sift
+    T pushPop(T val) {
+        if (heap.empty() || !(heap[0] < val)) return val;
+        T smallest = std::move(heap[0]);
+        siftDown(0, std::move(val));
+        return smallest;
     }
 
-    bool empty() { return heap.empty(); }
-    int size() { return heap.size(); }
-
-    void bubbleUp(int i) {
-        while (i > 0 && heap[i] < heap[parent(i)]) {
-            T temp = heap[i];
-            heap[i] = heap[parent(i)];
-            heap[parent(i)] = temp;
-            i = parent(i);
-        }
+    // Smallest element; the heap must not be empty
+    const T& top() const {
+        return heap[0];
     }
 
-    void bubbleDown(int i) {
-        int minIndex = i;
-        int n = heap.size();
+    bool empty() const { return heap.empty(); }
+    int size() const { return heap.size(); }
 
-        while (true) {
-            int l = left(i);
-            int r = right(i);
-            minIndex = i;
+    void clear() {
+        heap.clear();
+    }
 
-            if (l < n && heap[l] < heap[minIndex]) {
-                minIndex = l;
-            }
+    // Replace the contents with items and heapify bottom-up in O(n)
+    void build(SimpleVector<T> items) {
+        heap = std::move(items);
+        for (int i = heap.size() > 1 ? parent(heap.size() - 1) : -1; i >= 0; i--) {
+            T val = std::move(heap[i]);
+            siftDown(i, std::move(val));
+        }
+    }
 
-            if (r < n && heap[r] < heap[minIndex]) {
-                minIndex = r;
-            }
+    void siftUp(int hole) {
+        T val = std::move(heap[hole]);
+        while (hole > 0 && val < heap[parent(hole)]) {
+            heap[hole] = std::move(heap[parent(hole)]);
+            hole = parent(hole);
+        }
+        heap[hole] = std::move(val);
+    }
 
-            if (minIndex != i) {
-                T temp = heap[i];
-                heap[i] = heap[minIndex];
-                heap[minIndex] = temp;
-                i = minIndex;
-            } else {
-                break;
+    // Place val starting at the (empty) slot hole, pulling smaller children up
+    void siftDown(int hole, T val) {
+        int n = heap.size();
+        while (true) {
+            int child = firstChild(hole);
+            if (child >= n) break;
+            int end = child + Arity < n ? child + Arity : n;
+            int best = child;
+            for (int c = child + 1; c < end; c++) {
+                if (heap[c] < heap[best]) best = c;
             }
+            if (!(heap[best] < val)) break;
+            heap[hole] = std::move(heap[best]);
+            hole = best;
         }
+        heap[hole] = std::move(val);
     }
 };
 
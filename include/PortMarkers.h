@@ -0,0 +1,100 @@
+#ifndef PORTMARKERS_H
+#define PORTMARKERS_H
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include "Graph.h"
+#include "SimpleVector.h"
+
+// Port dots drawn as triangle fans in one sf::Triangles vertex array, so
+// all markers of a layer cost one draw call.
+
+const int MARKER_SEGMENTS = 12;                        // Triangles per disc
+const int MARKER_VERTICES = MARKER_SEGMENTS * 3;
+
+// Unit circle points shared by every disc
+inline const sf::Vector2f* markerCircle() {
+    static sf::Vector2f points[MARKER_SEGMENTS + 1];
+    static bool ready = false;
+    if (!ready) {
+        for (int i = 0; i <= MARKER_SEGMENTS; i++) {
+            float angle = 6.2831853f * static_cast<float>(i % MARKER_SEGMENTS) / MARKER_SEGMENTS;
+            points[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+        ready = true;
+    }
+    return points;
+}
+
+// Write a disc into the MARKER_VERTICES vertices starting at out
+inline void writeDisc(sf::Vertex* out, sf::Vector2f center, float radius, sf::Color color) {
+    const sf::Vector2f* circle = markerCircle();
+    for (int s = 0; s < MARKER_SEGMENTS; s++) {
+        out[s * 3] = sf::Vertex(center, color);
+        out[s * 3 + 1] = sf::Vertex(center + circle[s] * radius, color);
+        out[s * 3 + 2] = sf::Vertex(center + circle[s + 1] * radius, color);
+    }
+}
+
+inline void appendDisc(sf::VertexArray& out, sf::Vector2f center, float radius, sf::Color color) {
+    size_t start = out.getVertexCount();
+    out.resize(start + MARKER_VERTICES);
+    writeDisc(&out[start], center, radius, color);
+}
+
+// Disc with a border ring (like an sf::CircleShape outline drawn outside the radius)
+inline void appendRingedDisc(sf::VertexArray& out, sf::Vector2f center, float radius, sf::Color fill,
+                             float outline, sf::Color outlineColor) {
+    appendDisc(out, center, radius + outline, outlineColor);
+    appendDisc(out, center, radius, fill);
+}
+
+// One disc per port, in port order, each at a fixed vertex range so a
+// marker's size and color can be patched in place. Built once per graph
+// size; highlight() restyles single markers and clearHighlights() puts
+// them back, without touching the rest.
+struct PortMarkers {
+    sf::VertexArray vertices;
+    int portCount = -1;
+    float baseRadius = 3.0f;
+    sf::Color baseColor = sf::Color::Magenta;
+    SimpleVector<int> highlighted;  // Markers not in the base style
+
+    PortMarkers() : vertices(sf::Triangles) {}
+
+    bool isCurrent(const Graph& g) const {
+        return portCount == g.ports.size();
+    }
+
+    void build(const Graph& g, float radius, sf::Color color) {
+        portCount = g.ports.size();
+        baseRadius = radius;
+        baseColor = color;
+        highlighted.clear();
+        vertices.resize(static_cast<size_t>(portCount) * MARKER_VERTICES);
+        for (int i = 0; i < portCount; i++) {
+            writeMarker(g, i, radius, color);
+        }
+    }
+
+    void writeMarker(const Graph& g, int port, float radius, sf::Color color) {
+        const Port& p = g.ports[port];
+        writeDisc(&vertices[static_cast<size_t>(port) * MARKER_VERTICES],
+                  sf::Vector2f(static_cast<float>(p.x), static_cast<float>(p.y)), radius, color);
+    }
+
+    void highlight(const Graph& g, int port, float radius, sf::Color color) {
+        if (port < 0 || port >= portCount) return;
+        writeMarker(g, port, radius, color);
+        highlighted.push_back(port);
+    }
+
+    void clearHighlights(const Graph& g) {
+        for (int i = 0; i < highlighted.size(); i++) {
+            writeMarker(g, highlighted[i], baseRadius, baseColor);
+        }
+        highlighted.clear();
+    }
+};
+
+#endif
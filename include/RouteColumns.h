@@ -0,0 +1,269 @@
+#ifndef ROUTECOLUMNS_H
+#define ROUTECOLUMNS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "SimpleVector.h"
+#include "DataStructs.h"
+#include "MappedFile.h"
+#include "StringInterner.h"
+
+using namespace std;
+
+// Columnar route feed. Each route field is stored in its own column as a
+// run of zigzag varints, each value encoded as the difference from the
+// previous row's value. Port and company names are stored once in a
+// dictionary and the id columns refer to them, so a scan of one field
+// (e.g. cost) only reads that column's bytes.
+//
+// Layout: [header][dictionary: port names, company names][column 0]...[column 5]
+// Dictionary entries are a varint length followed by the name bytes.
+
+const char ROUTE_COLUMNS_MAGIC[8] = {'O', 'R', 'N', 'C', 'O', 'L', 'S', '\0'};
+const uint32_t ROUTE_COLUMNS_VERSION = 2;
+
+enum RouteColumn {
+    COLUMN_ORIGIN,       // Port dictionary id
+    COLUMN_DESTINATION,  // Port dictionary id
+    COLUMN_DEPARTURE,    // Departure, minutes since 1970-01-01
+    COLUMN_ARRIVAL,      // Arrival, minutes since 1970-01-01
+    COLUMN_COST,
+    COLUMN_COMPANY,      // Company dictionary id
+    ROUTE_COLUMN_COUNT
+};
+
+struct RouteColumnsHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+
+    uint32_t rowCount;
+    uint32_t reserved;
+    uint32_t portNameCount;
+    uint32_t companyNameCount;
+
+    uint64_t dictionaryOffset;
+    uint64_t dictionaryBytes;
+    uint64_t columnOffset[ROUTE_COLUMN_COUNT];
+    uint64_t columnBytes[ROUTE_COLUMN_COUNT];
+    uint64_t fileSize;
+};
+
+inline uint64_t zigzagEncode(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+inline void appendVarint(SimpleVector<unsigned char>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<unsigned char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+// Decode one varint; false if it runs past end or is over-long
+inline bool readVarint(const unsigned char*& p, const unsigned char* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) return false;
+        unsigned char byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+// Builds one delta-encoded column
+struct ColumnEncoder {
+    SimpleVector<unsigned char> bytes;
+    int64_t previous = 0;
+
+    void add(int64_t value) {
+        appendVarint(bytes, zigzagEncode(value - previous));
+        previous = value;
+    }
+};
+
+// Sequential reader over one column
+struct ColumnReader {
+    const unsigned char* p;
+    const unsigned char* end;
+    int64_t value = 0;
+
+    // Next row's value; false once the column is exhausted or corrupt
+    bool next(int64_t& out) {
+        uint64_t delta;
+        if (!readVarint(p, end, delta)) return false;
+        value += zigzagDecode(delta);
+        out = value;
+        return true;
+    }
+};
+
+// Builds a columnar route file row by row, so large feeds never need a
+// full Route store in memory
+struct RouteColumnsWriter {
+    StringInterner ports;
+    StringInterner companies;
+    ColumnEncoder columns[ROUTE_COLUMN_COUNT];
+    uint32_t rowCount = 0;
+
+    void add(const string& origin, const string& destination, long long departure, long long arrival, int cost, const string& company) {
+        columns[COLUMN_ORIGIN].add(ports.intern(origin));
+        columns[COLUMN_DESTINATION].add(ports.intern(destination));
+        columns[COLUMN_DEPARTURE].add(departure);
+        columns[COLUMN_ARRIVAL].add(arrival);
+        columns[COLUMN_COST].add(cost);
+        columns[COLUMN_COMPANY].add(companies.intern(company));
+        rowCount++;
+    }
+
+    // Write everything added so far to path (via a temp file + rename)
+    bool finish(const string& path) {
+        SimpleVector<unsigned char> dictionary;
+        auto appendNames = [&](const StringInterner& names) {
+            for (int i = 0; i < names.size(); i++) {
+                const string& s = names.get(i);
+                appendVarint(dictionary, s.size());
+                for (size_t k = 0; k < s.size(); k++) {
+                    dictionary.push_back(static_cast<unsigned char>(s[k]));
+                }
+            }
+        };
+        appendNames(ports);
+        appendNames(companies);
+
+        RouteColumnsHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, ROUTE_COLUMNS_MAGIC, sizeof(header.magic));
+        header.version = ROUTE_COLUMNS_VERSION;
+        header.headerSize = sizeof(RouteColumnsHeader);
+        header.rowCount = rowCount;
+        header.portNameCount = ports.size();
+        header.companyNameCount = companies.size();
+
+        uint64_t offset = sizeof(RouteColumnsHeader);
+        header.dictionaryOffset = offset;
+        header.dictionaryBytes = dictionary.size();
+        offset += dictionary.size();
+        for (int c = 0; c < ROUTE_COLUMN_COUNT; c++) {
+            header.columnOffset[c] = offset;
+            header.columnBytes[c] = columns[c].bytes.size();
+            offset += columns[c].bytes.size();
+        }
+        header.fileSize = offset;
+
+        string tempPath = path + ".tmp";
+        ofstream out(tempPath, ios::binary | ios::trunc);
+        if (!out.is_open()) {
+            cout << "Error: Could not write " << tempPath << endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (dictionary.size() > 0) {
+            out.write(reinterpret_cast<const char*>(&dictionary[0]), dictionary.size());
+        }
+        for (int c = 0; c < ROUTE_COLUMN_COUNT; c++) {
+            if (columns[c].bytes.size() > 0) {
+                out.write(reinterpret_cast<const char*>(&columns[c].bytes[0]), columns[c].bytes.size());
+            }
+        }
+        out.close();
+        if (!out) {
+            cout << "Error: Failed writing " << tempPath << endl;
+            remove(tempPath.c_str());
+            return false;
+        }
+        remove(path.c_str());
+        if (rename(tempPath.c_str(), path.c_str()) != 0) {
+            cout << "Error: Could not move " << tempPath << " into place" << endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+// Memory-mapped columnar route file
+struct RouteColumnsFile {
+    MappedFile file;
+    RouteColumnsHeader header;
+    SimpleVector<string> portNames;
+    SimpleVector<string> companyNames;
+
+    int rowCount() const {
+        return static_cast<int>(header.rowCount);
+    }
+
+    ColumnReader column(RouteColumn c) const {
+        ColumnReader reader;
+        reader.p = reinterpret_cast<const unsigned char*>(file.data) + header.columnOffset[c];
+        reader.end = reader.p + header.columnBytes[c];
+        return reader;
+    }
+
+    // Map path and read its dictionaries. Columns are decoded on demand.
+    bool open(const string& path) {
+        portNames.clear();
+        companyNames.clear();
+        if (!file.open(path)) return false;
+        if (file.length < sizeof(RouteColumnsHeader)) return false;
+
+        memcpy(&header, file.data, sizeof(header));
+        if (memcmp(header.magic, ROUTE_COLUMNS_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != ROUTE_COLUMNS_VERSION ||
+            header.headerSize != sizeof(RouteColumnsHeader) ||
+            header.fileSize != file.length) {
+            cout << "Error: " << path << " is not a route columns file" << endl;
+            return false;
+        }
+
+        auto sectionFits = [&](uint64_t offset, uint64_t bytes) {
+            return offset <= file.length && bytes <= file.length - offset;
+        };
+        bool fits = sectionFits(header.dictionaryOffset, header.dictionaryBytes);
+        for (int c = 0; c < ROUTE_COLUMN_COUNT; c++) {
+            fits = fits && sectionFits(header.columnOffset[c], header.columnBytes[c]);
+        }
+        if (!fits) {
+            cout << "Error: " << path << " is truncated or corrupt" << endl;
+            return false;
+        }
+
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(file.data) + header.dictionaryOffset;
+        const unsigned char* end = p + header.dictionaryBytes;
+        auto readNames = [&](uint32_t count, SimpleVector<string>& names) {
+            for (uint32_t i = 0; i < count; i++) {
+                uint64_t len;
+                if (!readVarint(p, end, len) || len > static_cast<uint64_t>(end - p)) return false;
+                names.push_back(string(reinterpret_cast<const char*>(p), len));
+                p += len;
+            }
+            return true;
+        };
+        if (!readNames(header.portNameCount, portNames) || !readNames(header.companyNameCount, companyNames)) {
+            cout << "Error: " << path << " has a corrupt name dictionary" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Encode routes into a columnar file at path
+    static bool write(const string& path, const SimpleVector<Route>& routes) {
+        RouteColumnsWriter writer;
+        for (int i = 0; i < routes.size(); i++) {
+            const Route& r = routes[i];
+            writer.add(r.origin, r.destination, r.departureDatetime, r.arrivalDatetime, r.cost, r.company);
+        }
+        return writer.finish(path);
+    }
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef ROUTELAYER_H
+#define ROUTELAYER_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include "Graph.h"
+#include "LineMesh.h"
+
+using namespace std;
+
+// The route network of one screen as a ready-to-draw vertex array, kept
+// between frames. It remembers what it was built from (graph version and
+// size, start port, company filter); the owner rebuilds it only when
+// isCurrent() says one of those changed, and draws it with one call.
+struct RouteLayer {
+    sf::VertexArray vertices;
+    bool built = false;
+    int graphVersion = -1;
+    int portCount = -1;
+    int startPort = -1;
+    string companyFilter;
+
+    RouteLayer() : vertices(sf::Lines) {}
+
+    bool isCurrent(const Graph& g, int start, const string& company) const {
+        return built && graphVersion == g.version && portCount == g.ports.size() &&
+               startPort == start && companyFilter == company;
+    }
+
+    // Start a rebuild for these inputs: sf::Lines for hairlines (addLine),
+    // sf::Triangles for lines with a width (addThickLine)
+    void begin(const Graph& g, int start, const string& company, sf::PrimitiveType type) {
+        vertices.clear();
+        vertices.setPrimitiveType(type);
+        built = true;
+        graphVersion = g.version;
+        portCount = g.ports.size();
+        startPort = start;
+        companyFilter = company;
+    }
+
+    void addLine(const Port& from, const Port& to, sf::Color color) {
+        vertices.append(sf::Vertex(sf::Vector2f(static_cast<float>(from.x), static_cast<float>(from.y)), color));
+        vertices.append(sf::Vertex(sf::Vector2f(static_cast<float>(to.x), static_cast<float>(to.y)), color));
+    }
+
+    void addThickLine(const Port& from, const Port& to, float width, sf::Color color) {
+        appendThickLine(vertices,
+                        sf::Vector2f(static_cast<float>(from.x), static_cast<float>(from.y)),
+                        sf::Vector2f(static_cast<float>(to.x), static_cast<float>(to.y)), width, color);
+    }
+
+    void invalidate() {
+        built = false;
+    }
+};
+
+#endif
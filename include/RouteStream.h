@@ -0,0 +1,254 @@
+#ifndef ROUTESTREAM_H
+#define ROUTESTREAM_H
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "SimpleVector.h"
+#include "SimpleList.h"
+#include "ConcurrentQueue.h"
+#include "DataStructs.h"
+#include "FileParser.h"
+#include "Graph.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// Schedule change records in an append-only routes stream:
+//   <Routes.txt line>                                          add a sailing
+//   CANCEL origin dest DD/MM/YYYY HH:MM company                remove a sailing
+//   UPDATE origin dest DD/MM/YYYY HH:MM HH:MM cost company     new arrival/cost
+// Sailings are identified by origin, destination, departure and company.
+enum RouteChangeType {
+    CHANGE_ADD,
+    CHANGE_CANCEL,
+    CHANGE_UPDATE
+};
+
+struct RouteChange {
+    RouteChangeType type;
+    Route route;
+};
+
+inline bool tokenEquals(const char* begin, const char* end, const char* word) {
+    size_t len = strlen(word);
+    return static_cast<size_t>(end - begin) == len && memcmp(begin, word, len) == 0;
+}
+
+// Parse one stream line into a change record
+inline LineStatus parseRouteChangeLine(const char* p, const char* lineEnd, RouteChange& change) {
+    LineTokens tok;
+    tok.split(p, lineEnd);
+    if (tok.count == 0) return LINE_BLANK;
+
+    if (tokenEquals(tok.begin[0], tok.end[0], "UPDATE")) {
+        change.type = CHANGE_UPDATE;
+        return parseRouteLine(tok.end[0], lineEnd, change.route);
+    }
+
+    if (tokenEquals(tok.begin[0], tok.end[0], "CANCEL")) {
+        if (tok.count != 6) return LINE_MALFORMED;
+        Date depDate;
+        int depMin;
+        if (!parseDateChars(tok.begin[3], tok.end[3], depDate) ||
+            !parseTimeChars(tok.begin[4], tok.end[4], depMin)) {
+            return LINE_MALFORMED;
+        }
+        Route& r = change.route;
+        r.origin.assign(tok.begin[1], tok.length(1));
+        r.destination.assign(tok.begin[2], tok.length(2));
+        r.departureDate.assign(tok.begin[3], tok.length(3));
+        r.depTime.assign(tok.begin[4], tok.length(4));
+        r.arrTime = r.depTime;
+        r.cost = 0;
+        r.company.assign(tok.begin[5], tok.length(5));
+        compileRouteTimes(r, depDate, depMin, depMin);
+        change.type = CHANGE_CANCEL;
+        return LINE_OK;
+    }
+
+    change.type = CHANGE_ADD;
+    return parseRouteLine(p, lineEnd, change.route);
+}
+
+// Tails an append-only routes stream on a background thread and hands
+// parsed changes to the UI thread through a lock-free queue. The graph is
+// only touched by applyPending(), which the owner calls between frames,
+// so the visualizer and every query see either none or all of a batch.
+struct RouteStream {
+    static const int PENDING_CAPACITY = 4096;
+
+    string filename;
+    int pollMillis = 500;
+
+    // Stream-owned storage for added sailings; list nodes never move, so edges can point into them
+    SimpleList<Route> ownedRoutes;
+
+    thread* worker = nullptr;
+    atomic<bool> running{false};
+
+    // Filled by the tail thread, drained by applyPending; the tail thread waits while it is full
+    ConcurrentQueue<RouteChange> pending{PENDING_CAPACITY};
+
+    // Tail-thread state
+    long long offset = 0;
+    string partialLine;
+    int lineNumber = 0;
+
+    ~RouteStream() {
+        stop();
+    }
+
+    bool start(const string& file) {
+        stop();
+        filename = file;
+        FileStamp stamp;
+        if (!getFileStamp(filename, stamp)) {
+            cout << "Error: Could not open route stream " << filename << endl;
+            return false;
+        }
+        offset = 0;
+        partialLine.clear();
+        lineNumber = 0;
+        running = true;
+        worker = new thread(&RouteStream::tailLoop, this);
+        return true;
+    }
+
+    void stop() {
+        running = false;
+        if (worker != nullptr) {
+            worker->join();
+            delete worker;
+            worker = nullptr;
+        }
+    }
+
+    void tailLoop() {
+        while (running) {
+            poll();
+            // Sleep in short slices so stop() stays responsive
+            for (int waited = 0; running && waited < pollMillis; waited += 50) {
+                this_thread::sleep_for(chrono::milliseconds(50));
+            }
+        }
+    }
+
+    // Read whatever was appended since the last poll and queue the parsed changes
+    void poll() {
+        FileStamp stamp;
+        if (!getFileStamp(filename, stamp)) return;
+        if (stamp.size < offset) {
+            // Truncated or replaced: start over from the top
+            cout << "[Stream] " << filename << " was truncated, re-reading from the start" << endl;
+            offset = 0;
+            partialLine.clear();
+            lineNumber = 0;
+        }
+        if (stamp.size == offset) return;
+
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) return;
+        file.seekg(offset);
+        string chunk = partialLine;
+        size_t carried = chunk.size();
+        chunk.resize(carried + static_cast<size_t>(stamp.size - offset));
+        file.read(&chunk[carried], stamp.size - offset);
+        size_t got = static_cast<size_t>(file.gcount());
+        chunk.resize(carried + got);
+        offset += got;
+
+        SimpleVector<RouteChange> batch;
+        const char* p = chunk.data();
+        const char* end = chunk.data() + chunk.size();
+        RouteChange change;
+        while (p < end) {
+            const char* lineEnd = findLineEnd(p, end);
+            if (lineEnd == end) break;  // Incomplete last line: wait for the rest
+            lineNumber++;
+
+            LineStatus status = parseRouteChangeLine(p, lineEnd, change);
+            if (status == LINE_OK) {
+                batch.push_back(change);
+            } else if (status == LINE_MALFORMED) {
+                cout << "Warning: " << filename << ": malformed change record at line " << lineNumber << endl;
+            }
+            p = lineEnd + 1;
+        }
+        partialLine.assign(p, end - p);
+
+        for (int i = 0; i < batch.size(); i++) {
+            if (!deliver(batch[i])) return;
+        }
+    }
+
+    // Queue one change for the UI thread, waiting while the queue is full.
+    // False if the stream was stopped before there was room.
+    bool deliver(RouteChange& change) {
+        while (!pending.tryPush(std::move(change))) {
+            if (!running) return false;
+            this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    // Apply every queued change to the graph in one go (UI thread only).
+    // Returns the number of changes applied.
+    int applyPending(Graph& graph) {
+        SimpleVector<RouteChange> batch;
+        RouteChange change;
+        while (pending.tryPop(change)) {
+            batch.push_back(std::move(change));
+        }
+        if (batch.size() == 0) return 0;
+
+        int applied = 0, skipped = 0;
+        for (int i = 0; i < batch.size(); i++) {
+            Route& r = batch[i].route;
+            r.originIdx = graph.getIndex(r.origin);
+            r.destinationIdx = graph.getIndex(r.destination);
+            if (r.originIdx == -1 || r.destinationIdx == -1) {
+                skipped++;
+                continue;
+            }
+
+            if (batch[i].type == CHANGE_ADD) {
+                ownedRoutes.push_back(r);
+                Route* stored = &ownedRoutes.tail->data;
+                graph.addEdgeByIndex(stored->originIdx, stored->destinationIdx, stored->cost, stored);
+                applied++;
+                continue;
+            }
+
+            Edge* edge = graph.findEdge(r.originIdx, r.destinationIdx, r.departureDatetime, r.company);
+            if (edge == nullptr) {
+                skipped++;
+                continue;
+            }
+            if (batch[i].type == CHANGE_CANCEL) {
+                graph.removeEdge(r.originIdx, edge->routeData);
+            } else {
+                Route* existing = edge->routeData;
+                existing->arrTime = r.arrTime;
+                existing->cost = r.cost;
+                existing->arrivalDatetime = r.arrivalDatetime;
+                existing->durationMinutes = r.durationMinutes;
+                edge->weight = r.cost;
+            }
+            applied++;
+        }
+
+        if (applied > 0) {
+            graph.version++;
+        }
+        cout << "[Stream] Applied " << applied << " schedule change(s)";
+        if (skipped > 0) cout << ", skipped " << skipped << " (unknown port or sailing)";
+        cout << endl;
+        return applied;
+    }
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef SIMPLEBITSET_H
+#define SIMPLEBITSET_H
+
+#include <cstdint>
+#include "SimpleVector.h"
+
+// Population count of one word
+inline int popcount64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Fixed-size set of bits packed 64 to a word: one bit per flag instead of
+// one byte, and whole-set operations (and/or/count) run a word at a time.
+// Bits past size() in the last word are kept zero.
+struct SimpleBitset {
+    SimpleVector<uint64_t> words;
+    int bitCount = 0;
+
+    SimpleBitset() {}
+    explicit SimpleBitset(Arena* a) : words(a) {}
+
+    static int wordCount(int bits) { return (bits + 63) >> 6; }
+
+    int size() const { return bitCount; }
+
+    // Resize to n bits, all cleared
+    void resize(int n) {
+        bitCount = n;
+        words.clear();
+        words.resize(wordCount(n), 0);
+    }
+
+    bool test(int i) const {
+        return (words[i >> 6] >> (i & 63)) & 1;
+    }
+
+    void set(int i) {
+        words[i >> 6] |= 1ULL << (i & 63);
+    }
+
+    void reset(int i) {
+        words[i >> 6] &= ~(1ULL << (i & 63));
+    }
+
+    // Sets bit i and returns whether it was already set
+    bool testAndSet(int i) {
+        uint64_t& w = words[i >> 6];
+        uint64_t bit = 1ULL << (i & 63);
+        bool was = (w & bit) != 0;
+        w |= bit;
+        return was;
+    }
+
+    void clearAll() {
+        for (int w = 0; w < words.size(); w++) words[w] = 0;
+    }
+
+    void setAll() {
+        for (int w = 0; w < words.size(); w++) words[w] = ~0ULL;
+        trimLastWord();
+    }
+
+    // Number of set bits
+    int count() const {
+        int total = 0;
+        for (int w = 0; w < words.size(); w++) total += popcount64(words[w]);
+        return total;
+    }
+
+    bool any() const {
+        for (int w = 0; w < words.size(); w++) {
+            if (words[w] != 0) return true;
+        }
+        return false;
+    }
+
+    // In-place set operations; other must have the same size
+    void andWith(const SimpleBitset& other) {
+        for (int w = 0; w < words.size(); w++) words[w] &= other.words[w];
+    }
+
+    void orWith(const SimpleBitset& other) {
+        for (int w = 0; w < words.size(); w++) words[w] |= other.words[w];
+    }
+
+    void andNotWith(const SimpleBitset& other) {
+        for (int w = 0; w < words.size(); w++) words[w] &= ~other.words[w];
+    }
+
+    // First set bit at or after i, or -1
+    int findNext(int i) const {
+        if (i >= bitCount) return -1;
+        int w = i >> 6;
+        uint64_t bits = words[w] & (~0ULL << (i & 63));
+        while (bits == 0) {
+            if (++w >= words.size()) return -1;
+            bits = words[w];
+        }
+        return (w << 6) + countTrailingZeros(bits);
+    }
+
+    static int countTrailingZeros(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(w);
+#else
+        return popcount64((w & (0 - w)) - 1);
+#endif
+    }
+
+    void trimLastWord() {
+        if (bitCount & 63) words[words.size() - 1] &= (1ULL << (bitCount & 63)) - 1;
+    }
+};
+
+#endif
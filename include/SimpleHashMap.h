@@ -0,0 +1,290 @@
+#ifndef SIMPLEHASHMAP_H
+#define SIMPLEHASHMAP_H
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <utility>
+#include "StringView.h"
+
+using namespace std;
+
+// FNV-1a hash over a character range
+inline unsigned long long hashChars(const char* s, size_t len) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Key hashes for the hash containers. Integers go through the splitmix64
+// finalizer so sequential ids spread over the whole table.
+inline unsigned long long hashKey(unsigned long long k) {
+    k = (k ^ (k >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    k = (k ^ (k >> 27)) * 0x94D049BB133111EBULL;
+    return k ^ (k >> 31);
+}
+
+inline unsigned long long hashKey(long long k) {
+    return hashKey(static_cast<unsigned long long>(k));
+}
+
+inline unsigned long long hashKey(int k) {
+    return hashKey(static_cast<unsigned long long>(static_cast<long long>(k)));
+}
+
+inline unsigned long long hashKey(const string& s) {
+    return hashChars(s.data(), s.size());
+}
+
+// Same hash as the string it views, so a string-keyed map can be probed with a view
+inline unsigned long long hashKey(StringView s) {
+    return hashChars(s.data, static_cast<size_t>(s.length));
+}
+
+// Open-addressing hash map with Robin Hood probing: on a collision the
+// entry that is closer to its home slot moves on, which keeps probe
+// lengths short and lets lookups for missing keys stop early. Erase
+// shifts the following entries back, so there are no tombstones.
+//
+// Lookups are templates so a key can be found with any type that hashes
+// the same through hashKey() and compares equal with == (e.g. a view of
+// a string). Slots are iterated by index:
+//   for (int i = 0; i < map.slotCount(); i++) if (map.occupied(i)) ... map.keyAt(i) ...
+template <typename K, typename V>
+struct SimpleHashMap {
+    K* keys = nullptr;
+    V* values = nullptr;
+    int* probe = nullptr;   // Per slot: 0 = empty, else distance from the home slot + 1
+    int count = 0;
+    int mask = -1;          // Slot count - 1 (slot count is a power of two)
+
+    SimpleHashMap() {}
+
+    SimpleHashMap(const SimpleHashMap& other) {
+        reserve(other.count);
+        for (int i = 0; i <= other.mask; i++) {
+            if (other.probe[i] != 0) insert(other.keys[i], other.values[i]);
+        }
+    }
+
+    SimpleHashMap(SimpleHashMap&& other) noexcept
+        : keys(other.keys), values(other.values), probe(other.probe), count(other.count), mask(other.mask) {
+        other.keys = nullptr;
+        other.values = nullptr;
+        other.probe = nullptr;
+        other.count = 0;
+        other.mask = -1;
+    }
+
+    SimpleHashMap& operator=(const SimpleHashMap& other) {
+        if (this != &other) {
+            SimpleHashMap copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    SimpleHashMap& operator=(SimpleHashMap&& other) noexcept {
+        if (this != &other) {
+            destroyAll();
+            keys = other.keys;
+            values = other.values;
+            probe = other.probe;
+            count = other.count;
+            mask = other.mask;
+            other.keys = nullptr;
+            other.values = nullptr;
+            other.probe = nullptr;
+            other.count = 0;
+            other.mask = -1;
+        }
+        return *this;
+    }
+
+    ~SimpleHashMap() {
+        destroyAll();
+    }
+
+    int size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    int slotCount() const {
+        return mask + 1;
+    }
+
+    bool occupied(int slot) const {
+        return probe[slot] != 0;
+    }
+
+    const K& keyAt(int slot) const {
+        return keys[slot];
+    }
+
+    V& valueAt(int slot) {
+        return values[slot];
+    }
+
+    const V& valueAt(int slot) const {
+        return values[slot];
+    }
+
+    // Slot holding key, or -1
+    template <typename Q>
+    int findSlot(const Q& key) const {
+        if (count == 0) return -1;
+        int slot = static_cast<int>(hashKey(key) & static_cast<unsigned long long>(mask));
+        for (int distance = 1; probe[slot] >= distance; distance++) {
+            if (keys[slot] == key) return slot;
+            slot = (slot + 1) & mask;
+        }
+        return -1;
+    }
+
+    template <typename Q>
+    V* find(const Q& key) {
+        int slot = findSlot(key);
+        return slot == -1 ? nullptr : &values[slot];
+    }
+
+    template <typename Q>
+    const V* find(const Q& key) const {
+        int slot = findSlot(key);
+        return slot == -1 ? nullptr : &values[slot];
+    }
+
+    template <typename Q>
+    bool contains(const Q& key) const {
+        return findSlot(key) != -1;
+    }
+
+    // Adds key -> value; an existing entry for key is left unchanged.
+    // Returns whether the key was new.
+    bool insert(const K& key, const V& value) {
+        if (findSlot(key) != -1) return false;
+        place(K(key), V(value));
+        return true;
+    }
+
+    // Value for key, default-constructed first if key is new
+    V& operator[](const K& key) {
+        int slot = findSlot(key);
+        if (slot != -1) return values[slot];
+        return values[place(K(key), V())];
+    }
+
+    template <typename Q>
+    bool erase(const Q& key) {
+        int slot = findSlot(key);
+        if (slot == -1) return false;
+        keys[slot].~K();
+        values[slot].~V();
+        // Shift the rest of the cluster back one slot
+        int next = (slot + 1) & mask;
+        while (probe[next] > 1) {
+            new (&keys[slot]) K(std::move(keys[next]));
+            new (&values[slot]) V(std::move(values[next]));
+            probe[slot] = probe[next] - 1;
+            keys[next].~K();
+            values[next].~V();
+            slot = next;
+            next = (next + 1) & mask;
+        }
+        probe[slot] = 0;
+        count--;
+        return true;
+    }
+
+    // Room for n entries without rehashing
+    void reserve(int n) {
+        int needed = 8;
+        while (needed * 4 < n * 5) needed *= 2;  // Keep the load at or below 80%
+        if (needed > mask + 1) rehash(needed);
+    }
+
+    void clear() {
+        for (int i = 0; i <= mask; i++) {
+            if (probe[i] != 0) {
+                keys[i].~K();
+                values[i].~V();
+                probe[i] = 0;
+            }
+        }
+        count = 0;
+    }
+
+    // Robin Hood insert of a key known to be absent; returns its slot
+    int place(K key, V value) {
+        if ((count + 1) * 5 > (mask + 1) * 4) {
+            rehash(mask < 0 ? 8 : (mask + 1) * 2);
+        }
+        int slot = static_cast<int>(hashKey(key) & static_cast<unsigned long long>(mask));
+        int distance = 1;
+        int placedAt = -1;
+        while (true) {
+            if (probe[slot] == 0) {
+                new (&keys[slot]) K(std::move(key));
+                new (&values[slot]) V(std::move(value));
+                probe[slot] = distance;
+                count++;
+                return placedAt == -1 ? slot : placedAt;
+            }
+            if (probe[slot] < distance) {
+                // The resident is closer to home: take its slot and carry it on
+                swap(key, keys[slot]);
+                swap(value, values[slot]);
+                int residentDistance = probe[slot];
+                probe[slot] = distance;
+                distance = residentDistance;
+                if (placedAt == -1) placedAt = slot;
+            }
+            slot = (slot + 1) & mask;
+            distance++;
+        }
+    }
+
+    void rehash(int slots) {
+        K* oldKeys = keys;
+        V* oldValues = values;
+        int* oldProbe = probe;
+        int oldSlots = mask + 1;
+
+        keys = static_cast<K*>(::operator new(sizeof(K) * static_cast<size_t>(slots)));
+        values = static_cast<V*>(::operator new(sizeof(V) * static_cast<size_t>(slots)));
+        probe = new int[slots];
+        for (int i = 0; i < slots; i++) probe[i] = 0;
+        mask = slots - 1;
+        count = 0;
+
+        for (int i = 0; i < oldSlots; i++) {
+            if (oldProbe[i] != 0) {
+                place(std::move(oldKeys[i]), std::move(oldValues[i]));
+                oldKeys[i].~K();
+                oldValues[i].~V();
+            }
+        }
+        ::operator delete(oldKeys);
+        ::operator delete(oldValues);
+        delete[] oldProbe;
+    }
+
+    void destroyAll() {
+        clear();
+        ::operator delete(keys);
+        ::operator delete(values);
+        delete[] probe;
+        keys = nullptr;
+        values = nullptr;
+        probe = nullptr;
+        mask = -1;
+    }
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SIMPLEHASHSET_H
+#define SIMPLEHASHSET_H
+
+#include "SimpleHashMap.h"
+
+// Robin Hood hash set: a SimpleHashMap whose values carry nothing
+template <typename K>
+struct SimpleHashSet {
+    struct NoValue {};
+
+    SimpleHashMap<K, NoValue> map;
+
+    int size() const { return map.size(); }
+    bool empty() const { return map.empty(); }
+    void reserve(int n) { map.reserve(n); }
+    void clear() { map.clear(); }
+
+    // Returns whether key was new
+    bool insert(const K& key) {
+        return map.insert(key, NoValue());
+    }
+
+    template <typename Q>
+    bool contains(const Q& key) const {
+        return map.contains(key);
+    }
+
+    template <typename Q>
+    bool erase(const Q& key) {
+        return map.erase(key);
+    }
+
+    // Iterate by slot: for (int i = 0; i < set.slotCount(); i++) if (set.occupied(i)) ... set.keyAt(i)
+    int slotCount() const { return map.slotCount(); }
+    bool occupied(int slot) const { return map.occupied(slot); }
+    const K& keyAt(int slot) const { return map.keyAt(slot); }
+};
+
+#endif
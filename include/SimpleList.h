@@ -1,35 +1,197 @@
 #ifndef SIMPLELIST_H
 #define SIMPLELIST_H
 
+#include <mutex>
+#include <new>
+#include <utility>
+#include "SimpleVector.h"
+
+using namespace std;
+
 template <typename T>
 struct Node {
     T data;
     Node* next;
 
-    Node(T val) : data(val), next(nullptr) {}
+    Node(const T& val) : data(val), next(nullptr) {}
+    Node(T&& val) : data(std::move(val)), next(nullptr) {}
+};
+
+// Node storage shared by every SimpleList<T>. Nodes are carved out of
+// slabs and recycled through a free list instead of each going through
+// new/delete. Any thread may create and destroy nodes, including nodes
+// created on another thread, at any time up to the end of static
+// destruction. Free lists are per thread, so only taking a fresh slab
+// locks; when a thread exits (the loader, RouteStream), its free nodes and
+// the rest of its slab go to a shared list that the next thread short of
+// nodes takes over. Nodes freed after that (e.g. by a static destroyed at
+// exit) go straight to the shared list. Slabs are never released, so the
+// pool stays at its peak size until the process exits.
+template <typename T>
+struct NodePool {
+    static const int SLAB_NODES = 256;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    // Never destroyed, so nodes can still be freed during static destruction
+    struct Slabs {
+        mutex lock;
+        SimpleVector<void*> blocks;
+        FreeNode* orphaned = nullptr;  // Free nodes left by exited threads
+    };
+
+    struct FreeList {
+        FreeNode* head = nullptr;
+        Node<T>* slab = nullptr;
+        int slabUsed = SLAB_NODES;
+
+        // Hand everything this thread still holds to the shared list
+        ~FreeList() {
+            exited() = true;
+            while (slabUsed < SLAB_NODES) {
+                FreeNode* freed = new (slab + slabUsed++) FreeNode;
+                freed->next = head;
+                head = freed;
+            }
+            if (head == nullptr) return;
+            FreeNode* last = head;
+            while (last->next != nullptr) last = last->next;
+            Slabs& s = slabs();
+            lock_guard<mutex> guard(s.lock);
+            last->next = s.orphaned;
+            s.orphaned = head;
+        }
+    };
+
+    static Slabs& slabs() {
+        static Slabs* s = new Slabs();
+        return *s;
+    }
+
+    static FreeList& local() {
+        thread_local FreeList f;
+        return f;
+    }
+
+    // Set once this thread's FreeList is gone; plain bool, so it stays readable
+    static bool& exited() {
+        thread_local bool e = false;
+        return e;
+    }
+
+    // Carve a fresh slab; the caller holds the lock
+    static Node<T>* newSlab(Slabs& s) {
+        void* block = ::operator new(sizeof(Node<T>) * SLAB_NODES);
+        s.blocks.push_back(block);
+        return static_cast<Node<T>*>(block);
+    }
+
+    template <typename... Args>
+    static Node<T>* create(Args&&... args) {
+        void* p;
+        if (exited()) {
+            Slabs& s = slabs();
+            lock_guard<mutex> guard(s.lock);
+            if (s.orphaned == nullptr) {
+                Node<T>* slab = newSlab(s);
+                for (int i = 0; i < SLAB_NODES; i++) {
+                    FreeNode* freed = new (slab + i) FreeNode;
+                    freed->next = s.orphaned;
+                    s.orphaned = freed;
+                }
+            }
+            p = s.orphaned;
+            s.orphaned = s.orphaned->next;
+            return new (p) Node<T>(std::forward<Args>(args)...);
+        }
+
+        FreeList& f = local();
+        if (f.head == nullptr && f.slabUsed == SLAB_NODES) {
+            Slabs& s = slabs();
+            lock_guard<mutex> guard(s.lock);
+            if (s.orphaned != nullptr) {
+                f.head = s.orphaned;
+                s.orphaned = nullptr;
+            } else {
+                f.slab = newSlab(s);
+                f.slabUsed = 0;
+            }
+        }
+        if (f.head != nullptr) {
+            p = f.head;
+            f.head = f.head->next;
+        } else {
+            p = f.slab + f.slabUsed++;
+        }
+        return new (p) Node<T>(std::forward<Args>(args)...);
+    }
+
+    static void destroy(Node<T>* node) {
+        node->~Node<T>();
+        FreeNode* freed = new (node) FreeNode;
+        if (exited()) {
+            Slabs& s = slabs();
+            lock_guard<mutex> guard(s.lock);
+            freed->next = s.orphaned;
+            s.orphaned = freed;
+            return;
+        }
+        FreeList& f = local();
+        freed->next = f.head;
+        f.head = freed;
+    }
 };
 
 template <typename T>
 struct SimpleList {
     Node<T>* head;
     Node<T>* tail;
+    int count;
+
+    SimpleList() : head(nullptr), tail(nullptr), count(0) {}
+
+    SimpleList(const SimpleList& other) : head(nullptr), tail(nullptr), count(0) {
+        for (Node<T>* current = other.head; current != nullptr; current = current->next) {
+            push_back(current->data);
+        }
+    }
 
-    SimpleList() {
-        head = nullptr;
-        tail = nullptr;
+    SimpleList(SimpleList&& other) noexcept : head(other.head), tail(other.tail), count(other.count) {
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.count = 0;
     }
 
-    ~SimpleList() {
-        Node<T>* current = head;
-        while (current != nullptr) {
-            Node<T>* nextNode = current->next;
-            delete current;
-            current = nextNode;
+    SimpleList& operator=(const SimpleList& other) {
+        if (this != &other) {
+            clear();
+            for (Node<T>* current = other.head; current != nullptr; current = current->next) {
+                push_back(current->data);
+            }
         }
+        return *this;
     }
 
-    void push_back(const T& value) {
-        Node<T>* newNode = new Node<T>(value);
+    SimpleList& operator=(SimpleList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = other.head;
+            tail = other.tail;
+            count = other.count;
+            other.head = nullptr;
+            other.tail = nullptr;
+            other.count = 0;
+        }
+        return *this;
+    }
+
+    ~SimpleList() {
+        clear();
+    }
+
+    void link(Node<T>* newNode) {
         if (head == nullptr) {
             head = newNode;
             tail = newNode;
@@ -37,73 +199,61 @@ struct SimpleList {
             tail->next = newNode;
             tail = newNode;
         }
+        count++;
     }
 
-    void remove(const T& value) {
-        if (head == nullptr) return;
+    void push_back(const T& value) {
+        link(NodePool<T>::create(value));
+    }
 
-        if (head->data == value) {
-            Node<T>* temp = head;
-            head = head->next;
-            if (head == nullptr) tail = nullptr;
-            delete temp;
-            return;
-        }
+    void push_back(T&& value) {
+        link(NodePool<T>::create(std::move(value)));
+    }
 
-        Node<T>* current = head;
-        while (current->next != nullptr && current->next->data != value) {
-            current = current->next;
-        }
+    // Unlink and free node; prev is the node before it (nullptr at the head)
+    void erase(Node<T>* prev, Node<T>* node) {
+        if (prev == nullptr) head = node->next;
+        else prev->next = node->next;
+        if (tail == node) tail = prev;
+        count--;
+        NodePool<T>::destroy(node);
+    }
 
-        if (current->next != nullptr) {
-            Node<T>* toDelete = current->next;
-            current->next = toDelete->next;
-            
-            if (toDelete == tail) {
-                tail = current;
+    void remove(const T& value) {
+        Node<T>* prev = nullptr;
+        for (Node<T>* current = head; current != nullptr; current = current->next) {
+            if (current->data == value) {
+                erase(prev, current);
+                return;
             }
-            delete toDelete;
+            prev = current;
         }
     }
 
     Node<T>* begin() {
         return head;
     }
-    
-    bool empty() {
+
+    bool empty() const {
         return head == nullptr;
     }
-    
+
     void clear() {
         while (head != nullptr) {
             pop_front();
         }
     }
-    
+
     int size() const {
-        int count = 0;
-        Node<T>* current = head;
-        while (current != nullptr) {
-            count++;
-            current = current->next;
-        }
         return count;
     }
 
-    // Remove and return the front element (for queue operations)
+    // Remove the front element (for queue operations)
     void pop_front() {
-        if (head == nullptr) return;
-        
-        Node<T>* temp = head;
-        head = head->next;
-        
-        // If list became empty, update tail
-        if (head == nullptr) {
-            tail = nullptr;
+        if (head != nullptr) {
+            erase(nullptr, head);
         }
-        
-        delete temp;
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,40 +1,139 @@
 #ifndef SIMPLEQUEUE_H
 #define SIMPLEQUEUE_H
 
-#include "SimpleList.h"
+#include <new>
+#include <utility>
 
+// FIFO queue on a growable ring buffer: push, pop and size are O(1) and
+// the elements sit in one contiguous block. Storage is only allocated on
+// the first push and doubles (power of two) when full.
 template <typename T>
 struct SimpleQueue {
-    SimpleList<T> list;
+    T* data;
+    int first;     // Slot of the front element
+    int count;
+    int capacity;  // Zero or a power of two
 
-    void push(T val) {
-        list.push_back(val);
+    SimpleQueue() : data(nullptr), first(0), count(0), capacity(0) {}
+
+    SimpleQueue(const SimpleQueue& other) : data(nullptr), first(0), count(0), capacity(0) {
+        reserve(other.count);
+        for (int i = 0; i < other.count; i++) {
+            new (data + i) T(other.at(i));
+        }
+        count = other.count;
     }
 
-    void pop() {
-        list.pop_front();
+    SimpleQueue(SimpleQueue&& other) noexcept
+        : data(other.data), first(other.first), count(other.count), capacity(other.capacity) {
+        other.data = nullptr;
+        other.first = other.count = other.capacity = 0;
+    }
+
+    SimpleQueue& operator=(const SimpleQueue& other) {
+        if (this != &other) {
+            SimpleQueue copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
     }
 
-    T front() {
-        if (list.head != nullptr) {
-            return list.head->data;
+    SimpleQueue& operator=(SimpleQueue&& other) noexcept {
+        if (this != &other) {
+            clear();
+            ::operator delete(data);
+            data = other.data;
+            first = other.first;
+            count = other.count;
+            capacity = other.capacity;
+            other.data = nullptr;
+            other.first = other.count = other.capacity = 0;
         }
-        return T();  // Return default if empty
+        return *this;
+    }
+
+    ~SimpleQueue() {
+        clear();
+        ::operator delete(data);
     }
 
-    bool empty() {
-        return list.empty();
+    // i-th element from the front
+    T& at(int i) {
+        return data[(first + i) & (capacity - 1)];
     }
 
-    int size() {
-        int count = 0;
-        Node<T>* current = list.head;
-        while (current != nullptr) {
-            count++;
-            current = current->next;
+    const T& at(int i) const {
+        return data[(first + i) & (capacity - 1)];
+    }
+
+    // Room for n elements; also unwraps the ring so the front is slot 0
+    void reserve(int n) {
+        if (n <= capacity) return;
+        int newCapacity = capacity > 0 ? capacity : 8;
+        while (newCapacity < n) newCapacity *= 2;
+        T* newData = static_cast<T*>(::operator new(sizeof(T) * static_cast<size_t>(newCapacity)));
+        for (int i = 0; i < count; i++) {
+            T& item = at(i);
+            new (newData + i) T(std::move(item));
+            item.~T();
+        }
+        ::operator delete(data);
+        data = newData;
+        first = 0;
+        capacity = newCapacity;
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        if (count == capacity) {
+            // Build first: args may refer to an element about to move
+            T item(std::forward<Args>(args)...);
+            reserve(count + 1);
+            new (&at(count)) T(std::move(item));
+        } else {
+            new (&at(count)) T(std::forward<Args>(args)...);
         }
+        count++;
+    }
+
+    void push(const T& val) {
+        emplace(val);
+    }
+
+    void push(T&& val) {
+        emplace(std::move(val));
+    }
+
+    void pop() {
+        if (count == 0) return;
+        data[first].~T();
+        first = (first + 1) & (capacity - 1);
+        count--;
+    }
+
+    // Front element; the queue must not be empty
+    T& front() {
+        return data[first];
+    }
+
+    const T& front() const {
+        return data[first];
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    int size() const {
         return count;
     }
+
+    void clear() {
+        while (count > 0) {
+            pop();
+        }
+        first = 0;
+    }
 };
 
 #endif
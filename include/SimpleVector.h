@@ -1,66 +1,157 @@
 #ifndef SIMPLEVECTOR_H
 #define SIMPLEVECTOR_H
 
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "Arena.h"
+
+// Growable array on raw storage: slots past size() are never constructed,
+// so reserving room for n Ports does not build n Ports. Elements are moved
+// (not copied) when the storage grows. A vector given an Arena takes its
+// storage from there and never frees it; such a vector must not outlive
+// the arena's current scope (copies go back to the heap).
 template <typename T>
 struct SimpleVector {
     T* data;
     int currentSize;
     int capacity;
+    Arena* arena;
 
-    SimpleVector() {
-        capacity = 10;
-        currentSize = 0;
-        data = new T[capacity];
-    }
+    SimpleVector() : data(nullptr), currentSize(0), capacity(0), arena(nullptr) {}
 
-    SimpleVector(const SimpleVector& other) {
-        capacity = other.capacity;
-        currentSize = other.currentSize;
-        data = new T[capacity];
-        for (int i = 0; i < currentSize; i++) {
-            data[i] = other.data[i];
+    explicit SimpleVector(Arena* a) : data(nullptr), currentSize(0), capacity(0), arena(a) {}
+
+    SimpleVector(const SimpleVector& other) : data(nullptr), currentSize(0), capacity(0), arena(nullptr) {
+        reserve(other.currentSize);
+        for (int i = 0; i < other.currentSize; i++) {
+            new (data + i) T(other.data[i]);
         }
+        currentSize = other.currentSize;
+    }
+
+    SimpleVector(SimpleVector&& other) noexcept
+        : data(other.data), currentSize(other.currentSize), capacity(other.capacity), arena(other.arena) {
+        other.data = nullptr;
+        other.currentSize = 0;
+        other.capacity = 0;
     }
 
     SimpleVector& operator=(const SimpleVector& other) {
         if (this != &other) {
-            delete[] data;
-            capacity = other.capacity;
-            currentSize = other.currentSize;
-            data = new T[capacity];
-            for (int i = 0; i < currentSize; i++) {
-                data[i] = other.data[i];
+            clear();
+            reserve(other.currentSize);
+            for (int i = 0; i < other.currentSize; i++) {
+                new (data + i) T(other.data[i]);
             }
+            currentSize = other.currentSize;
+        }
+        return *this;
+    }
+
+    SimpleVector& operator=(SimpleVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release(data);
+            data = other.data;
+            currentSize = other.currentSize;
+            capacity = other.capacity;
+            arena = other.arena;
+            other.data = nullptr;
+            other.currentSize = 0;
+            other.capacity = 0;
         }
         return *this;
     }
 
     ~SimpleVector() {
-        delete[] data;
+        clear();
+        release(data);
     }
 
-    void push_back(const T& value) {
+    T* allocate(int n) {
+        size_t bytes = sizeof(T) * static_cast<size_t>(n);
+        if (arena != nullptr) return static_cast<T*>(arena->allocate(bytes, alignof(T)));
+        return static_cast<T*>(::operator new(bytes));
+    }
+
+    void release(T* p) {
+        if (arena == nullptr) ::operator delete(p);
+    }
+
+    // Move the live elements into newData (capacity newCapacity) and adopt it
+    void adopt(T* newData, int newCapacity) {
+        for (int i = 0; i < currentSize; i++) {
+            new (newData + i) T(std::move(data[i]));
+            data[i].~T();
+        }
+        release(data);
+        data = newData;
+        capacity = newCapacity;
+    }
+
+    void reserve(int n) {
+        if (n > capacity) {
+            adopt(allocate(n), n);
+        }
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
         if (currentSize >= capacity) {
-            int newCapacity = capacity * 2;
-            T* newData = new T[newCapacity];
-            for (int i = 0; i < currentSize; i++) {
-                newData[i] = data[i];
-            }
-            delete[] data;
-            data = newData;
-            capacity = newCapacity;
+            int newCapacity = capacity > 0 ? capacity * 2 : 10;
+            T* newData = allocate(newCapacity);
+            // Build the new element first: args may refer to an element of the old storage
+            new (newData + currentSize) T(std::forward<Args>(args)...);
+            adopt(newData, newCapacity);
+        } else {
+            new (data + currentSize) T(std::forward<Args>(args)...);
         }
-        data[currentSize] = value;
         currentSize++;
+        return data[currentSize - 1];
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
     }
 
     void pop_back() {
         if (currentSize > 0) {
             currentSize--;
+            data[currentSize].~T();
         }
     }
-    
-    bool contains(const T& value) {
+
+    // Grow with value-initialized elements or shrink from the back
+    void resize(int n) {
+        reserve(n);
+        while (currentSize < n) {
+            new (data + currentSize) T();
+            currentSize++;
+        }
+        while (currentSize > n) {
+            pop_back();
+        }
+    }
+
+    // Grow with copies of value or shrink from the back
+    void resize(int n, const T& value) {
+        T fill(value);  // value may live in the storage reserve() is about to move
+        reserve(n);
+        while (currentSize < n) {
+            new (data + currentSize) T(fill);
+            currentSize++;
+        }
+        while (currentSize > n) {
+            pop_back();
+        }
+    }
+
+    bool contains(const T& value) const {
         for (int i = 0; i < currentSize; i++) {
             if (data[i] == value) return true;
         }
@@ -70,7 +161,7 @@ struct SimpleVector {
     T& operator[](int index) {
         return data[index];
     }
-    
+
     const T& operator[](int index) const {
         return data[index];
     }
@@ -82,10 +173,14 @@ struct SimpleVector {
     bool empty() const {
         return currentSize == 0;
     }
-    
+
+    // Destroys the elements but keeps the storage for reuse
     void clear() {
+        for (int i = 0; i < currentSize; i++) {
+            data[i].~T();
+        }
         currentSize = 0;
     }
 };
 
-#endif
\ No newline at end of file
+#endif
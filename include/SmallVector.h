@@ -0,0 +1,189 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// SimpleVector with room for N elements inside the object itself. Up to N
+// elements need no heap allocation; past that it spills to the heap and
+// grows like SimpleVector. Same interface, so it drops in for short lists
+// (route paths, per-query scratch).
+template <typename T, int N>
+struct SmallVector {
+    T* data;
+    int currentSize;
+    int capacity;
+    alignas(T) unsigned char inlineStorage[sizeof(T) * N];
+
+    SmallVector() : data(inlineBuffer()), currentSize(0), capacity(N) {}
+
+    SmallVector(const SmallVector& other) : data(inlineBuffer()), currentSize(0), capacity(N) {
+        reserve(other.currentSize);
+        for (int i = 0; i < other.currentSize; i++) {
+            new (data + i) T(other.data[i]);
+        }
+        currentSize = other.currentSize;
+    }
+
+    SmallVector(SmallVector&& other) noexcept : data(inlineBuffer()), currentSize(0), capacity(N) {
+        takeFrom(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.currentSize);
+            for (int i = 0; i < other.currentSize; i++) {
+                new (data + i) T(other.data[i]);
+            }
+            currentSize = other.currentSize;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            if (!isInline()) {
+                ::operator delete(data);
+                data = inlineBuffer();
+                capacity = N;
+            }
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        if (!isInline()) {
+            ::operator delete(data);
+        }
+    }
+
+    T* inlineBuffer() {
+        return reinterpret_cast<T*>(inlineStorage);
+    }
+
+    bool isInline() const {
+        return data == reinterpret_cast<const T*>(inlineStorage);
+    }
+
+    // Steal other's heap buffer, or move its inline elements one by one (this must be empty and inline)
+    void takeFrom(SmallVector& other) {
+        if (other.isInline()) {
+            for (int i = 0; i < other.currentSize; i++) {
+                new (data + i) T(std::move(other.data[i]));
+            }
+            currentSize = other.currentSize;
+            other.clear();
+        } else {
+            data = other.data;
+            currentSize = other.currentSize;
+            capacity = other.capacity;
+            other.data = other.inlineBuffer();
+            other.currentSize = 0;
+            other.capacity = N;
+        }
+    }
+
+    // Move the live elements into newData (capacity newCapacity) and adopt it
+    void adopt(T* newData, int newCapacity) {
+        for (int i = 0; i < currentSize; i++) {
+            new (newData + i) T(std::move(data[i]));
+            data[i].~T();
+        }
+        if (!isInline()) {
+            ::operator delete(data);
+        }
+        data = newData;
+        capacity = newCapacity;
+    }
+
+    static T* allocate(int n) {
+        return static_cast<T*>(::operator new(sizeof(T) * static_cast<size_t>(n)));
+    }
+
+    void reserve(int n) {
+        if (n > capacity) {
+            adopt(allocate(n), n);
+        }
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (currentSize >= capacity) {
+            int newCapacity = capacity * 2;
+            T* newData = allocate(newCapacity);
+            // Build the new element first: args may refer to an element of the old storage
+            new (newData + currentSize) T(std::forward<Args>(args)...);
+            adopt(newData, newCapacity);
+        } else {
+            new (data + currentSize) T(std::forward<Args>(args)...);
+        }
+        currentSize++;
+        return data[currentSize - 1];
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() {
+        if (currentSize > 0) {
+            currentSize--;
+            data[currentSize].~T();
+        }
+    }
+
+    // Grow with copies of value or shrink from the back
+    void resize(int n, const T& value = T()) {
+        T fill(value);  // value may live in the storage reserve() is about to move
+        reserve(n);
+        while (currentSize < n) {
+            new (data + currentSize) T(fill);
+            currentSize++;
+        }
+        while (currentSize > n) {
+            pop_back();
+        }
+    }
+
+    bool contains(const T& value) const {
+        for (int i = 0; i < currentSize; i++) {
+            if (data[i] == value) return true;
+        }
+        return false;
+    }
+
+    T& operator[](int index) {
+        return data[index];
+    }
+
+    const T& operator[](int index) const {
+        return data[index];
+    }
+
+    int size() const {
+        return currentSize;
+    }
+
+    bool empty() const {
+        return currentSize == 0;
+    }
+
+    // Destroys the elements but keeps the storage for reuse
+    void clear() {
+        for (int i = 0; i < currentSize; i++) {
+            data[i].~T();
+        }
+        currentSize = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include "SimpleVector.h"
+#include "SmallVector.h"
+
+// Non-owning, read-only view of a contiguous run of T (a SimpleVector, a
+// SmallVector or a plain array). The elements must outlive the span.
+template <typename T>
+struct Span {
+    const T* data;
+    int length;
+
+    Span() : data(nullptr), length(0) {}
+    Span(const T* d, int len) : data(d), length(len) {}
+    Span(const SimpleVector<T>& v) : data(v.data), length(v.size()) {}
+
+    template <int N>
+    Span(const SmallVector<T, N>& v) : data(v.data), length(v.size()) {}
+
+    int size() const { return length; }
+    bool empty() const { return length == 0; }
+    const T& operator[](int i) const { return data[i]; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + length; }
+};
+
+#endif
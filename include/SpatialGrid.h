@@ -0,0 +1,130 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "SimpleVector.h"
+#include "DataStructs.h"
+
+// Uniform grid over port screen coordinates for hover/click hit-testing.
+// Ports are bucketed by cell (counting sort), so a radius query only
+// visits the handful of cells the search circle overlaps.
+struct SpatialGrid {
+    float cellSize;
+    float originX, originY;
+    int cols, rows;
+
+    SimpleVector<int> cellStart;   // cellStart[c]..cellStart[c + 1] indexes cellItems
+    SimpleVector<int> cellItems;   // Port indices grouped by cell
+    SimpleVector<float> itemX;     // Screen position per port index
+    SimpleVector<float> itemY;
+
+    SpatialGrid() : cellSize(32.0f), originX(0), originY(0), cols(0), rows(0) {}
+
+    int cellOf(float x, float y) const {
+        int cx = static_cast<int>((x - originX) / cellSize);
+        int cy = static_cast<int>((y - originY) / cellSize);
+        if (cx < 0) cx = 0;
+        if (cy < 0) cy = 0;
+        if (cx >= cols) cx = cols - 1;
+        if (cy >= rows) cy = rows - 1;
+        return cy * cols + cx;
+    }
+
+    // Rebuild from current port screen positions.
+    // Must be called again whenever the view (zoom/pan) moves the ports.
+    void build(const SimpleVector<Port>& ports, float cell = 32.0f) {
+        cellStart.clear();
+        cellItems.clear();
+        itemX.clear();
+        itemY.clear();
+        cols = rows = 0;
+
+        int n = ports.size();
+        if (n == 0) return;
+
+        float minX = static_cast<float>(ports[0].x), maxX = minX;
+        float minY = static_cast<float>(ports[0].y), maxY = minY;
+        for (int i = 0; i < n; i++) {
+            float x = static_cast<float>(ports[i].x);
+            float y = static_cast<float>(ports[i].y);
+            itemX.push_back(x);
+            itemY.push_back(y);
+            if (x < minX) minX = x;
+            if (x > maxX) maxX = x;
+            if (y < minY) minY = y;
+            if (y > maxY) maxY = y;
+        }
+
+        // Widen cells if the extent would need far more cells than ports
+        cellSize = cell;
+        while (((maxX - minX) / cellSize + 1) * ((maxY - minY) / cellSize + 1) > 4.0f * n + 64) {
+            cellSize *= 2.0f;
+        }
+
+        originX = minX;
+        originY = minY;
+        cols = static_cast<int>((maxX - minX) / cellSize) + 1;
+        rows = static_cast<int>((maxY - minY) / cellSize) + 1;
+        int cellCount = cols * rows;
+
+        // Count ports per cell, prefix-sum into start offsets, then scatter
+        for (int c = 0; c <= cellCount; c++) {
+            cellStart.push_back(0);
+        }
+        for (int i = 0; i < n; i++) {
+            cellStart[cellOf(itemX[i], itemY[i]) + 1]++;
+        }
+        for (int c = 0; c < cellCount; c++) {
+            cellStart[c + 1] += cellStart[c];
+        }
+
+        SimpleVector<int> fill;
+        for (int c = 0; c < cellCount; c++) {
+            fill.push_back(cellStart[c]);
+        }
+        for (int i = 0; i < n; i++) {
+            cellItems.push_back(0);
+        }
+        for (int i = 0; i < n; i++) {
+            int c = cellOf(itemX[i], itemY[i]);
+            cellItems[fill[c]++] = i;
+        }
+    }
+
+    // Closest port strictly within radius of (x, y), or -1 if none.
+    // Ties go to the lower port index.
+    int nearest(float x, float y, float radius) const {
+        if (cols == 0) return -1;
+
+        int minCx = static_cast<int>((x - radius - originX) / cellSize);
+        int maxCx = static_cast<int>((x + radius - originX) / cellSize);
+        int minCy = static_cast<int>((y - radius - originY) / cellSize);
+        int maxCy = static_cast<int>((y + radius - originY) / cellSize);
+        if (x + radius < originX || y + radius < originY) return -1;
+        if (minCx < 0) minCx = 0;
+        if (minCy < 0) minCy = 0;
+        if (maxCx >= cols) maxCx = cols - 1;
+        if (maxCy >= rows) maxCy = rows - 1;
+
+        int best = -1;
+        float bestDistSq = radius * radius;
+        for (int cy = minCy; cy <= maxCy; cy++) {
+            for (int cx = minCx; cx <= maxCx; cx++) {
+                int c = cy * cols + cx;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+                    int i = cellItems[k];
+                    float dx = itemX[i] - x;
+                    float dy = itemY[i] - y;
+                    float distSq = dx * dx + dy * dy;
+                    // Lower index wins ties, so the result does not depend on cell order
+                    if (distSq < bestDistSq || (distSq == bestDistSq && best != -1 && i < best)) {
+                        bestDistSq = distSq;
+                        best = i;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+};
+
+#endif
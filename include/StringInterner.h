@@ -0,0 +1,119 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+
+#include <string>
+#include <cstring>
+#include <mutex>
+#include "SimpleVector.h"
+#include "SimpleHashMap.h"
+
+using namespace std;
+
+// Assigns dense ids (0, 1, 2, ...) to distinct strings in first-seen order.
+// Lookups go through an open-addressing table of ids keyed by FNV-1a hash.
+struct StringInterner {
+    SimpleVector<string> strings;   // id -> string
+    SimpleVector<int> slots;        // Hash table of ids, -1 = empty
+    int mask = -1;
+
+    int size() const {
+        return strings.size();
+    }
+
+    const string& get(int id) const {
+        return strings[id];
+    }
+
+    int find(const char* s, size_t len) const {
+        if (mask < 0) return -1;
+        int slot = static_cast<int>(hashChars(s, len) & mask);
+        while (slots[slot] != -1) {
+            const string& candidate = strings[slots[slot]];
+            if (candidate.size() == len && memcmp(candidate.data(), s, len) == 0) {
+                return slots[slot];
+            }
+            slot = (slot + 1) & mask;
+        }
+        return -1;
+    }
+
+    int find(const string& s) const {
+        return find(s.data(), s.size());
+    }
+
+    int intern(const char* s, size_t len) {
+        int id = find(s, len);
+        if (id != -1) return id;
+
+        if ((strings.size() + 1) * 2 > mask + 1) {
+            grow();
+        }
+        id = strings.size();
+        strings.push_back(string(s, len));
+        insertSlot(id);
+        return id;
+    }
+
+    int intern(const string& s) {
+        return intern(s.data(), s.size());
+    }
+
+    void clear() {
+        strings.clear();
+        slots.clear();
+        mask = -1;
+    }
+
+    void insertSlot(int id) {
+        const string& s = strings[id];
+        int slot = static_cast<int>(hashChars(s.data(), s.size()) & mask);
+        while (slots[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+
+    void grow() {
+        int capacity = (mask < 0) ? 64 : (mask + 1) * 2;
+        slots.clear();
+        for (int i = 0; i < capacity; i++) {
+            slots.push_back(-1);
+        }
+        mask = capacity - 1;
+        for (int id = 0; id < strings.size(); id++) {
+            insertSlot(id);
+        }
+    }
+};
+
+// Thread-safe interner for parallel loaders. Strings are sharded by hash,
+// each shard being a StringInterner behind its own lock, so threads only
+// contend when they hit the same shard at the same time.
+// Ids are (shard-local id * SHARD_COUNT + shard): unique but not dense.
+struct ConcurrentStringInterner {
+    static const int SHARD_COUNT = 16;
+    StringInterner shards[SHARD_COUNT];
+    mutex locks[SHARD_COUNT];
+
+    static int shardOf(const char* s, size_t len) {
+        // High bits pick the shard; the shard's own table uses the low bits
+        return static_cast<int>((hashChars(s, len) >> 40) % SHARD_COUNT);
+    }
+
+    int intern(const char* s, size_t len) {
+        int shard = shardOf(s, len);
+        lock_guard<mutex> guard(locks[shard]);
+        return shards[shard].intern(s, len) * SHARD_COUNT + shard;
+    }
+
+    int intern(const string& s) {
+        return intern(s.data(), s.size());
+    }
+
+    // Not synchronized: only call once all interning threads have finished
+    const string& get(int id) const {
+        return shards[id % SHARD_COUNT].get(id / SHARD_COUNT);
+    }
+};
+
+#endif
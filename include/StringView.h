@@ -0,0 +1,51 @@
+#ifndef STRINGVIEW_H
+#define STRINGVIEW_H
+
+#include <cstring>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+// Non-owning view of characters owned elsewhere (a string, a literal, a
+// mapped file). Cheap to pass by value; the characters must outlive it.
+struct StringView {
+    const char* data;
+    int length;
+
+    StringView() : data(""), length(0) {}
+    StringView(const char* s) : data(s), length(static_cast<int>(strlen(s))) {}
+    StringView(const char* s, int len) : data(s), length(len) {}
+    StringView(const char* begin, const char* end) : data(begin), length(static_cast<int>(end - begin)) {}
+    StringView(const string& s) : data(s.data()), length(static_cast<int>(s.size())) {}
+
+    int size() const { return length; }
+    bool empty() const { return length == 0; }
+    char operator[](int i) const { return data[i]; }
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+
+    StringView substr(int start, int len) const {
+        if (start > length) start = length;
+        if (len > length - start) len = length - start;
+        return StringView(data + start, len);
+    }
+
+    // Owning copy, for when the text has to be kept
+    string str() const { return string(data, static_cast<size_t>(length)); }
+};
+
+// Also covers string == view: the string converts to a view, no copy
+inline bool operator==(StringView a, StringView b) {
+    return a.length == b.length && (a.length == 0 || memcmp(a.data, b.data, static_cast<size_t>(a.length)) == 0);
+}
+
+inline bool operator!=(StringView a, StringView b) {
+    return !(a == b);
+}
+
+inline ostream& operator<<(ostream& out, StringView s) {
+    return out.write(s.data, s.length);
+}
+
+#endif
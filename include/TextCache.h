@@ -0,0 +1,118 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include "SimpleHashMap.h"
+#include "SimpleVector.h"
+#include "StringView.h"
+
+using namespace std;
+
+// What a laid-out text depends on; colour and position are not part of it
+struct TextKey {
+    const sf::Font* font;
+    string str;
+    unsigned size;
+    sf::Uint32 style;
+};
+
+// The same key over a borrowed string, for lookups that should not copy
+struct TextKeyView {
+    const sf::Font* font;
+    StringView str;
+    unsigned size;
+    sf::Uint32 style;
+};
+
+inline unsigned long long hashKey(const TextKeyView& k) {
+    unsigned long long h = hashKey(k.str);
+    h ^= hashKey(static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(k.font)) * 31 + k.size * 7 + k.style);
+    return h;
+}
+
+inline unsigned long long hashKey(const TextKey& k) {
+    return hashKey(TextKeyView{k.font, k.str, k.size, k.style});
+}
+
+inline bool operator==(const TextKey& a, const TextKeyView& b) {
+    return a.font == b.font && a.size == b.size && a.style == b.style && a.str == b.str;
+}
+
+inline bool operator==(const TextKey& a, const TextKey& b) {
+    return a == TextKeyView{b.font, b.str, b.size, b.style};
+}
+
+// sf::Text objects kept from frame to frame, so a label is laid out once
+// instead of every time it is drawn. get() returns the cached text for a
+// (font, string, size, style); callers set colour and position, which do
+// not redo the glyph layout, and getLocalBounds() on it is already
+// computed. Texts not used for EVICT_AFTER_FRAMES frames are dropped, so
+// changing strings (times, costs) do not pile up.
+struct TextCache {
+    static const int EVICT_AFTER_FRAMES = 120;
+
+    struct Entry {
+        sf::Text text;
+        int lastUsed;
+    };
+
+    SimpleHashMap<TextKey, Entry*> entries;  // Entries are heap nodes so references survive rehashing
+    int frame = 0;
+
+    TextCache() {}
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    ~TextCache() {
+        clear();
+    }
+
+    sf::Text& get(const sf::Font& font, StringView str, unsigned size, sf::Uint32 style = sf::Text::Regular) {
+        TextKeyView key{&font, str, size, style};
+        Entry** found = entries.find(key);
+        if (found != nullptr) {
+            (*found)->lastUsed = frame;
+            return (*found)->text;
+        }
+
+        Entry* entry = new Entry();
+        entry->text.setFont(font);
+        entry->text.setString(str.str());
+        entry->text.setCharacterSize(size);
+        entry->text.setStyle(style);
+        entry->text.getLocalBounds();  // Lay out now, while it is known to be needed
+        entry->lastUsed = frame;
+        entries.insert(TextKey{&font, str.str(), size, style}, entry);
+        return entry->text;
+    }
+
+    // Call once per frame, after drawing
+    void endFrame() {
+        frame++;
+        if (frame % EVICT_AFTER_FRAMES != 0) return;
+
+        SimpleVector<TextKey> stale;
+        for (int i = 0; i < entries.slotCount(); i++) {
+            if (entries.occupied(i) && frame - entries.valueAt(i)->lastUsed > EVICT_AFTER_FRAMES) {
+                stale.push_back(entries.keyAt(i));
+            }
+        }
+        for (int i = 0; i < stale.size(); i++) {
+            Entry** found = entries.find(stale[i]);
+            delete *found;
+            entries.erase(stale[i]);
+        }
+    }
+
+    // Drop everything (e.g. after the font changes)
+    void clear() {
+        for (int i = 0; i < entries.slotCount(); i++) {
+            if (entries.occupied(i)) delete entries.valueAt(i);
+        }
+        entries.clear();
+    }
+};
+
+#endif
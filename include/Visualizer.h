@@ -9,8 +9,56 @@
 #include "Graph.h"
 #include "DataStructs.h"
 #include "SimpleVector.h"
+#include "SmallVector.h"
 #include "Algorithms.h"
 #include "UIComponents.h"
+#include "SpatialGrid.h"
+#include "RouteLayer.h"
+#include "LineMesh.h"
+#include "PortMarkers.h"
+#include "TextCache.h"
+#include "SimpleHashMap.h"
+#include "SimpleHashSet.h"
+#include "RouteStream.h"
+#include "DataLoader.h"
+
+// Redraw pacing: animation is capped at FRAME_RATE_CAP; while loading, streaming
+// or showing a text cursor the loop checks for input every EVENT_SLICE_MS and
+// for loader/stream progress every POLL_INTERVAL_MS; otherwise it sleeps in
+// waitEvent until the user does something
+const unsigned FRAME_RATE_CAP = 60;
+const int POLL_INTERVAL_MS = 100;
+const int EVENT_SLICE_MS = 5;
+const int CURSOR_BLINK_MS = 500;  // Matches InputBox's blink
+
+// Everything hover highlighting depends on, so a mouse move that changes
+// nothing can be ignored. Compared field by field.
+struct HoverState {
+    static const int FLAG_COUNT = 15;
+    bool flags[FLAG_COUNT] = {};
+    SmallVector<bool, 8> removeWaypoint;  // One per waypoint remove button
+    int portIdx = -1;
+    int menuIndex = -1;
+
+    bool operator==(const HoverState& other) const {
+        if (portIdx != other.portIdx || menuIndex != other.menuIndex) return false;
+        for (int i = 0; i < FLAG_COUNT; i++) {
+            if (flags[i] != other.flags[i]) return false;
+        }
+        if (removeWaypoint.size() != other.removeWaypoint.size()) return false;
+        for (int i = 0; i < removeWaypoint.size(); i++) {
+            if (removeWaypoint[i] != other.removeWaypoint[i]) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const HoverState& other) const {
+        return !(*this == other);
+    }
+};
+
+// Departure dates tried per multi-leg search in dated mode (each is a full search on the UI thread)
+const int MULTI_LEG_SEARCH_DAYS = 31;
 
 class OceanVisualizer {
 private:
@@ -24,13 +72,28 @@ private:
     sf::Sprite iconSprite;
     sf::Font font;
     sf::Font titleFont;
+    DataLoader* loader;
     Graph* graph;
+    RouteStream* routeStream = nullptr;  // Live schedule changes, if streaming
+    Arena frameArena;                    // Scratch for draw code; reset at the start of every frame
+    bool assetsApplied = false;          // Textures/font created from the loader's images
+    bool graphApplied = false;           // Graph loaded; screens other than the menu unlocked
+    RouteLayer bookingRoutes;            // Route network lines, rebuilt only when their inputs change
+    RouteLayer companyRoutes;
+    sf::VertexArray pathMesh{sf::Triangles};  // Highlighted paths, re-tessellated each frame
+    PortMarkers portMarkers;                  // Every port as a magenta dot; selections patched in place
+    sf::VertexArray markerMesh{sf::Triangles};  // Waypoint/path markers, rebuilt each frame
+    TextCache texts;                          // Laid-out labels, reused across frames
+    bool frameDirty = true;                   // Something on screen changed; draw on the next pass
+    HoverState lastHoverState;
+    int lastLoadProgress = -1;
+    sf::Clock blinkClock;                     // Time since the last redraw for a focused input's cursor
 
     int startPortIdx = -1;
     int endPortIdx = -1;
     int hoverPortIdx = -1;
     bool isAnimating = false;
-    SimpleVector<int> currentPath;
+    SmallVector<int, PATH_INLINE_PORTS> currentPath;
     
     bool hoverMenuBooking = false;
     bool hoverMenuCompany = false;
@@ -109,32 +172,47 @@ private:
     
     int lastDisplayedSegment = -1;
     bool journeyInfoVisible = false;
+    
+    // Spatial index over port screen positions (hover/click hit-testing)
+    SpatialGrid portGrid;
+    SimpleHashMap<string, int> portByLowerName;  // Lower-cased name -> first port with it
+
+    // Reused membership sets for the per-frame port lists
+    SimpleHashSet<int> companyPortsSeen;
+    SimpleHashSet<int> pathPortsSeen;
 
     float distance(float x1, float y1, float x2, float y2) {
         return sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1));
     }
 
+    // Rebuild the port hit-test grid (call whenever port screen positions change, e.g. zoom/pan)
+    // and the case-insensitive name index
+    void rebuildPortIndex() {
+        portGrid.build(graph->ports);
+        portByLowerName.clear();
+        portByLowerName.reserve(graph->ports.size());
+        for (int i = 0; i < graph->ports.size(); i++) {
+            portByLowerName.insert(lowerCase(graph->ports[i].name), i);
+        }
+    }
+
+    static string lowerCase(string s) {
+        for (size_t i = 0; i < s.size(); i++) {
+            s[i] = tolower(s[i]);
+        }
+        return s;
+    }
+
+    // Port under the given screen point (within click/hover radius), or -1
+    int portAt(float mx, float my) {
+        return portGrid.nearest(mx, my, 15.0f);
+    }
+
     // Case-insensitive port name lookup
     int findPortIndex(const string& name) {
         if (name.empty()) return -1;
-        
-        string lowerName = name;
-        for (size_t i = 0; i < lowerName.size(); i++) {
-            lowerName[i] = tolower(lowerName[i]);
-        }
-        
-        for (int i = 0; i < graph->ports.size(); i++) {
-            string portName = graph->ports[i].name;
-            string lowerPort = portName;
-            for (size_t j = 0; j < lowerPort.size(); j++) {
-                lowerPort[j] = tolower(lowerPort[j]);
-            }
-            
-            if (lowerPort == lowerName) {
-                return i;
-            }
-        }
-        return -1;
+        const int* index = portByLowerName.find(lowerCase(name));
+        return index != nullptr ? *index : -1;
     }
     
     // Validate port name inputs and set visual state
@@ -184,35 +262,41 @@ private:
         }
     }
     
-    // Get selected day from input
-    int getSelectedDay() {
-        string dayText = dayInput->getText();
-        if (dayText.empty()) return 1;
+    // Read one date field, falling back to def and clamping to [lo, hi]
+    int readDateField(InputBox* input, int def, int lo, int hi) {
+        string text = input->getText();
+        if (text.empty()) return def;
         try {
-            int d = stoi(dayText);
-            if (d < 1) return 1;
-            if (d > 31) return 31;
-            return d;
+            int v = stoi(text);
+            if (v < lo) return lo;
+            if (v > hi) return hi;
+            return v;
         } catch (...) {
-            return 1;
+            return def;
         }
     }
 
+    // Get selected departure date from the day/month/year inputs
+    Date getSelectedDate() {
+        Date d;
+        d.year = readDateField(yearInput, 2024, 1, 9999);
+        d.month = readDateField(monthInput, 12, 1, 12);
+        d.day = readDateField(dayInput, 1, 1, daysInMonth(d.year, d.month));
+        return d;
+    }
+
+    // Absolute minute at which the selected departure day starts
+    double getSelectedDayStart() {
+        return (double)dateTimeToMinutes(getSelectedDate(), 0);
+    }
+
 public:
-    OceanVisualizer(Graph* g) : graph(g) {
+    OceanVisualizer(DataLoader* l) : loader(l), graph(&l->graph) {
         window.create(sf::VideoMode(1350, 850), "Ocean Route Navigator - Maritime Logistics");
+        window.setFramerateLimit(FRAME_RATE_CAP);
         
-        if (!mapTexture.loadFromFile("../assets/world_map.png")) {
-            cout << "Error: Could not load world_map.png" << endl;
-        }
-        mapSprite.setTexture(mapTexture);
+        // Map, icon and font arrive from the background loader (see applyLoadedData)
         mapSprite.setPosition(0.f, 0.f);
-        
-        if (!font.loadFromFile("../assets/arial.ttf")) {
-            cout << "Warning: Could not load font (arial.ttf)" << endl;
-        }
-        
-        titleFont = font;
 
         sidePanel.setSize(sf::Vector2f(300.f, 700.f));
         sidePanel.setPosition(1050.f, 0.f);
@@ -322,19 +406,6 @@ public:
         initMenuBtn(menuBtnCompanyRoutes, 580.f, sf::Color(60, 120, 80), sf::Color(100, 180, 120));
         initMenuBtn(menuBtnExit, 660.f, sf::Color(150, 50, 50), sf::Color(200, 100, 100));
         
-        // Load menu icon
-        if (!iconTexture.loadFromFile("../assets/icon.jpg")) {
-            std::cerr << "Warning: Could not load icon.jpg from assets folder" << std::endl;
-        }
-        iconSprite.setTexture(iconTexture);
-        // Scale icon to target width
-        sf::Vector2u iconSize = iconTexture.getSize();
-        if (iconSize.x > 0 && iconSize.y > 0) {
-            float targetWidth = 200.f;
-            float scale = targetWidth / static_cast<float>(iconSize.x);
-            iconSprite.setScale(scale, scale);
-        }
-        
         // Initialize company names for company routes screen (exact names from Routes.txt)
         allCompanies.push_back("MaerskLine");
         allCompanies.push_back("MSC");
@@ -383,6 +454,46 @@ public:
         calcJourneyBtn.setOutlineThickness(2.f);
     }
 
+    // Pick up whatever the background loader has finished. Textures are
+    // created here because they need the UI thread's OpenGL context.
+    void applyLoadedData() {
+        if (!assetsApplied && loader->assetsReady) {
+            sf::Vector2u mapSize = loader->mapImage.getSize();
+            if (mapSize.x > 0 && mapSize.y > 0 && mapTexture.loadFromImage(loader->mapImage)) {
+                mapSprite.setTexture(mapTexture, true);
+            }
+
+            // Scale icon to target width
+            sf::Vector2u iconSize = loader->iconImage.getSize();
+            if (iconSize.x > 0 && iconSize.y > 0 && iconTexture.loadFromImage(loader->iconImage)) {
+                iconSprite.setTexture(iconTexture, true);
+                float targetWidth = 200.f;
+                float scale = targetWidth / static_cast<float>(iconSize.x);
+                iconSprite.setScale(scale, scale);
+            }
+
+            // Text objects hold a pointer to font, so loading into it updates them all
+            if (!loader->fontBytes.empty() && font.loadFromMemory(loader->fontBytes.data(), loader->fontBytes.size())) {
+                titleFont = font;
+            }
+            texts.clear();  // Layouts made before the font arrived are empty
+
+            assetsApplied = true;
+        }
+
+        if (!graphApplied && loader->graphReady) {
+            rebuildPortIndex();
+            graphApplied = true;
+        }
+    }
+
+    // Screens other than the menu need the graph; ignore them until it is loaded
+    void openScreen(ScreenState screen) {
+        if (graphApplied) {
+            currentScreen = screen;
+        }
+    }
+
     // Handle mouse clicks and input events
     void handleInput(sf::Event& event) {
         // Handle keyboard navigation in menu
@@ -394,9 +505,9 @@ public:
             } else if (event.key.code == sf::Keyboard::Return || event.key.code == sf::Keyboard::Enter) {
                 // Activate selected menu option
                 switch (selectedMenuIndex) {
-                    case 0: currentScreen = BOOKING; break;
-                    case 1: currentScreen = MULTI_LEG; break;
-                    case 2: currentScreen = COMPANIES; break;
+                    case 0: openScreen(BOOKING); break;
+                    case 1: openScreen(MULTI_LEG); break;
+                    case 2: openScreen(COMPANIES); break;
                     case 3: window.close(); break;
                 }
             }
@@ -411,13 +522,13 @@ public:
             if (currentScreen == MENU) {
                 if (menuBtnRouteBooking.getGlobalBounds().contains(mx, my)) {
                     selectedMenuIndex = 0;
-                    currentScreen = BOOKING;
+                    openScreen(BOOKING);
                 } else if (menuBtnMultiLeg.getGlobalBounds().contains(mx, my)) {
                     selectedMenuIndex = 1;
-                    currentScreen = MULTI_LEG;
+                    openScreen(MULTI_LEG);
                 } else if (menuBtnCompanyRoutes.getGlobalBounds().contains(mx, my)) {
                     selectedMenuIndex = 2;
-                    currentScreen = COMPANIES;
+                    openScreen(COMPANIES);
                 } else if (menuBtnExit.getGlobalBounds().contains(mx, my)) {
                     window.close();
                 }
@@ -526,15 +637,44 @@ public:
                 if (calcJourneyBtn.getGlobalBounds().contains(mx, my)) {
                     calculateAttempted = true;  // Mark that calculation has been attempted
                     if (multiLegWaypoints.size() >= 2) {
-                        cout << "[Multi-leg] Calculating journey across all dates..." << endl;
+                        cout << "[Multi-leg] Calculating journey across departure dates..." << endl;
                         
-                        // Try all departure dates (1-31 December) to find the best route
+                        // Try a bounded window of departure dates from the selected one: a week
+                        // for weekly timetables, else MULTI_LEG_SEARCH_DAYS clipped to the feed
                         MultiLegResult bestResult;
                         bestResult.isValid = false;
                         double bestMetric = 1e18;
                         
-                        for (int day = 1; day <= 31; day++) {
-                            MultiLegResult result = calculateMultiLegRoute(*graph, multiLegWaypoints, MODE_DIJKSTRA_TIME, day);
+                        Date selected = getSelectedDate();
+                        long long firstDay = daysFromCivil(selected.year, selected.month, selected.day);
+                        long long lastDay;
+                        if (graph->timetable == TIMETABLE_WEEKLY) {
+                            lastDay = firstDay + 6;
+                        } else {
+                            lastDay = firstDay + MULTI_LEG_SEARCH_DAYS - 1;
+                            long long feedFirst, feedLast;
+                            if (!graph->departureDayRange(feedFirst, feedLast)) {
+                                lastDay = firstDay - 1;  // No sailings at all
+                            } else {
+                                if (firstDay < feedFirst) firstDay = feedFirst;
+                                if (lastDay > feedLast) lastDay = feedLast;
+                            }
+                        }
+                        
+                        // Resolve the waypoint names once for all the dates tried
+                        SimpleVector<int> waypointPorts(&frameArena);
+                        waypointPorts.reserve(multiLegWaypoints.size());
+                        for (int i = 0; i < multiLegWaypoints.size(); i++) {
+                            int idx = graph->getIndex(multiLegWaypoints[i]);
+                            if (idx == -1) {
+                                lastDay = firstDay - 1;  // Unknown port: no date can work
+                                break;
+                            }
+                            waypointPorts.push_back(idx);
+                        }
+                        
+                        for (long long day = firstDay; day <= lastDay; day++) {
+                            MultiLegResult result = calculateMultiLegRoute(*graph, waypointPorts, MODE_DIJKSTRA_TIME, civilFromDays(day));
                             
                             if (result.isValid) {
                                 // Calculate total time for this result
@@ -555,7 +695,7 @@ public:
                         
                         if (lastMultiLegResult.isValid) {
                             multiLegErrorMessage = "";  // Clear error on success
-                            cout << "[Multi-leg] Journey found! Day: " << lastMultiLegResult.departureDay 
+                            cout << "[Multi-leg] Journey found! Date: " << formatDate(lastMultiLegResult.departureDate) 
                                  << " | Segments: " << lastMultiLegResult.segments.size() 
                                  << " | Total Time: " << (int)(bestMetric / 60) << "h " 
                                  << (int)bestMetric % 60 << "m" << endl;
@@ -599,68 +739,63 @@ public:
                 
                 if (mx < 1050.0f) {
                 bool clickedPort = false;
-                for (int i = 0; i < graph->ports.size(); i++) {
-                    Port& port = graph->ports[i];
-                    float dist = distance(mx, my, static_cast<float>(port.x), static_cast<float>(port.y));
-
-                    if (dist < 15.0f) {  // Click radius threshold
-                        clickedPort = true;
-
-                        if (startPortIdx == i) {
-                            startPortIdx = -1;
-                            endPortIdx = -1;
-                            originPortInput->setText("");
-                            originPortInput->setValidationState(VALIDATION_NEUTRAL);
-                            destPortInput->setText("");
-                            destPortInput->setValidationState(VALIDATION_NEUTRAL);
-                            currentPath.clear();
-                            isAnimating = false;
-                            if (journeyInfoVisible) {
-                                journeyInfoVisible = false;
-                                lastDisplayedSegment = -1;
-                            }
-                        } else if (endPortIdx == i) {
-                            endPortIdx = -1;
-                            destPortInput->setText("");
-                            destPortInput->setValidationState(VALIDATION_NEUTRAL);
-                            currentPath.clear();
-                            isAnimating = false;
-                            if (journeyInfoVisible) {
-                                journeyInfoVisible = false;
-                                lastDisplayedSegment = -1;
-                            }
-                        } else if (startPortIdx == -1) {
-                            startPortIdx = i;
-                            originPortInput->setText(graph->ports[i].name);
-                            originPortInput->setValidationState(VALIDATION_VALID);
-                            endPortIdx = -1;
-                            destPortInput->setText("");
-                            destPortInput->setValidationState(VALIDATION_NEUTRAL);
-                            currentPath.clear();
-                            isAnimating = false;
-                            if (journeyInfoVisible) {
-                                journeyInfoVisible = false;
-                                lastDisplayedSegment = -1;
-                            }
-                        } else if (endPortIdx == -1 && i != startPortIdx) {
-                            endPortIdx = i;
-                            destPortInput->setText(graph->ports[i].name);
-                            destPortInput->setValidationState(VALIDATION_VALID);
-                        } else {
-                            startPortIdx = i;
-                            originPortInput->setText(graph->ports[i].name);
-                            originPortInput->setValidationState(VALIDATION_VALID);
-                            endPortIdx = -1;
-                            destPortInput->setText("");
-                            destPortInput->setValidationState(VALIDATION_NEUTRAL);
-                            currentPath.clear();
-                            isAnimating = false;
-                            if (journeyInfoVisible) {
-                                journeyInfoVisible = false;
-                                lastDisplayedSegment = -1;
-                            }
+                int i = portAt(mx, my);
+                if (i != -1) {
+                    clickedPort = true;
+
+                    if (startPortIdx == i) {
+                        startPortIdx = -1;
+                        endPortIdx = -1;
+                        originPortInput->setText("");
+                        originPortInput->setValidationState(VALIDATION_NEUTRAL);
+                        destPortInput->setText("");
+                        destPortInput->setValidationState(VALIDATION_NEUTRAL);
+                        currentPath.clear();
+                        isAnimating = false;
+                        if (journeyInfoVisible) {
+                            journeyInfoVisible = false;
+                            lastDisplayedSegment = -1;
+                        }
+                    } else if (endPortIdx == i) {
+                        endPortIdx = -1;
+                        destPortInput->setText("");
+                        destPortInput->setValidationState(VALIDATION_NEUTRAL);
+                        currentPath.clear();
+                        isAnimating = false;
+                        if (journeyInfoVisible) {
+                            journeyInfoVisible = false;
+                            lastDisplayedSegment = -1;
+                        }
+                    } else if (startPortIdx == -1) {
+                        startPortIdx = i;
+                        originPortInput->setText(graph->ports[i].name);
+                        originPortInput->setValidationState(VALIDATION_VALID);
+                        endPortIdx = -1;
+                        destPortInput->setText("");
+                        destPortInput->setValidationState(VALIDATION_NEUTRAL);
+                        currentPath.clear();
+                        isAnimating = false;
+                        if (journeyInfoVisible) {
+                            journeyInfoVisible = false;
+                            lastDisplayedSegment = -1;
+                        }
+                    } else if (endPortIdx == -1 && i != startPortIdx) {
+                        endPortIdx = i;
+                        destPortInput->setText(graph->ports[i].name);
+                        destPortInput->setValidationState(VALIDATION_VALID);
+                    } else {
+                        startPortIdx = i;
+                        originPortInput->setText(graph->ports[i].name);
+                        originPortInput->setValidationState(VALIDATION_VALID);
+                        endPortIdx = -1;
+                        destPortInput->setText("");
+                        destPortInput->setValidationState(VALIDATION_NEUTRAL);
+                        currentPath.clear();
+                        isAnimating = false;
+                        if (journeyInfoVisible) {
+                            journeyInfoVisible = false;
+                            lastDisplayedSegment = -1;
                         }
-                        break;
                     }
                 }
             } else {
@@ -711,11 +846,9 @@ public:
                     validatePortInputs();
                     
                     if (startPortIdx != -1 && endPortIdx != -1 && !isAnimating) {
-                        string startName = graph->ports[startPortIdx].name;
-                        string endName = graph->ports[endPortIdx].name;
-                        int departureDay = getSelectedDay();
+                        Date departureDate = getSelectedDate();
 
-                            lastResult = findPath(*graph, startName, endName, currentMode, departureDay);
+                            lastResult = findPath(*graph, startPortIdx, endPortIdx, currentMode, departureDate);
                             // Mark that a search was executed for the current selection
                             resultComputed = true;
 
@@ -756,8 +889,7 @@ public:
                                 double layoverCosts = 0.0;
                                 
                                 // Start time calculation
-                                double decemberStartMinutes = 482400.0;
-                                double currentArrival = decemberStartMinutes + (getSelectedDay() - 1) * 1440.0;
+                                double currentArrival = getSelectedDayStart();
                                 
                                 for (int i = 0; i < lastResult.path.size() - 1; i++) {
                                     int u = lastResult.path[i];
@@ -768,23 +900,12 @@ public:
                                             Route* r = en->data.routeData;
                                             routeCosts += en->data.weight;
                                             
-                                            // Parse route times
-                                            Date depDate = parseDate(r->departureDate);
-                                            int depTimeMin = timeToMinutes(r->depTime);
-                                            int arrTimeMin = timeToMinutes(r->arrTime);
-                                            long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-                                            long long arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
-                                            
-                                            // Handle overnight routes
-                                            if (arrTimeMin < depTimeMin) {
-                                                arrivalDatetime += 1440;
-                                            }
+                                            // Compiled route times (overnight sailings already adjusted)
+                                            long long departureDatetime = r->departureDatetime;
+                                            long long arrivalDatetime = r->arrivalDatetime;
                                             
                                             // Find next valid departure (weekly cycling)
-                                            while (departureDatetime < currentArrival) {
-                                                departureDatetime += 10080;
-                                                arrivalDatetime += 10080;
-                                            }
+                                            alignSailing(graph->timetable, departureDatetime, arrivalDatetime, currentArrival);
                                             
                                             // Calculate wait and layover for intermediate ports (not at start or end)
                                             if (i > 0 && i < lastResult.path.size() - 1) {
@@ -816,8 +937,7 @@ public:
                                 double waitTime = 0.0;
                                 
                                 // Start time calculation
-                                double decemberStartMinutes = 482400.0;
-                                double currentArrival = decemberStartMinutes + (getSelectedDay() - 1) * 1440.0;
+                                double currentArrival = getSelectedDayStart();
                                 
                                 for (int i = 0; i < lastResult.path.size() - 1; i++) {
                                     int u = lastResult.path[i];
@@ -828,23 +948,12 @@ public:
                                             Route* r = en->data.routeData;
                                             sailTime += r->durationMinutes;
                                             
-                                            // Parse route times
-                                            Date depDate = parseDate(r->departureDate);
-                                            int depTimeMin = timeToMinutes(r->depTime);
-                                            int arrTimeMin = timeToMinutes(r->arrTime);
-                                            long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-                                            long long arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
-                                            
-                                            // Handle overnight routes
-                                            if (arrTimeMin < depTimeMin) {
-                                                arrivalDatetime += 1440;
-                                            }
+                                            // Compiled route times (overnight sailings already adjusted)
+                                            long long departureDatetime = r->departureDatetime;
+                                            long long arrivalDatetime = r->arrivalDatetime;
                                             
                                             // Find next valid departure (weekly cycling)
-                                            while (departureDatetime < currentArrival) {
-                                                departureDatetime += 10080;
-                                                arrivalDatetime += 10080;
-                                            }
+                                            alignSailing(graph->timetable, departureDatetime, arrivalDatetime, currentArrival);
                                             
                                             // Calculate wait time for intermediate ports (not at start)
                                             if (i > 0) {
@@ -874,7 +983,7 @@ public:
                         } else {
                             pathFound = false;
                             currentPath.clear();
-                            cout << "\n[!] No Path Found between " << startName << " and " << endName << "\n" << endl;
+                            cout << "\n[!] No Path Found between " << graph->ports[startPortIdx].name << " and " << graph->ports[endPortIdx].name << "\n" << endl;
                         }
                     }
                 }
@@ -982,15 +1091,7 @@ public:
             
             // Check port hover (only in map area)
             if (mx < 1050.0f) {
-                for (int i = 0; i < graph->ports.size(); i++) {
-                    Port& port = graph->ports[i];
-                    float dist = distance(mx, my, static_cast<float>(port.x), static_cast<float>(port.y));
-                    
-                    if (dist < 15.0f) {
-                        hoverPortIdx = i;
-                        break;
-                    }
-                }
+                hoverPortIdx = portAt(mx, my);
             } else {
                 // Check UI button hovers (in side panel)
                 hoverDijkstraCost = btnDijkstraCost.getGlobalBounds().contains(mx, my);
@@ -1008,15 +1109,7 @@ public:
             
             // Check port hover (only in map area)
             if (mx < 1050.0f) {
-                for (int i = 0; i < graph->ports.size(); i++) {
-                    Port& port = graph->ports[i];
-                    float dist = distance(mx, my, static_cast<float>(port.x), static_cast<float>(port.y));
-                    
-                    if (dist < 15.0f) {
-                        hoverPortIdx = i;
-                        break;
-                    }
-                }
+                hoverPortIdx = portAt(mx, my);
             }
         } else if (currentScreen == MULTI_LEG) {
             // Check back button
@@ -1024,15 +1117,7 @@ public:
             
             // Check port hover (only in map area)
             if (mx < 1050.0f) {
-                for (int i = 0; i < graph->ports.size(); i++) {
-                    Port& port = graph->ports[i];
-                    float dist = distance(mx, my, static_cast<float>(port.x), static_cast<float>(port.y));
-                    
-                    if (dist < 15.0f) {
-                        hoverPortIdx = i;
-                        break;
-                    }
-                }
+                hoverPortIdx = portAt(mx, my);
             } else {
                 // Check multi-leg UI button hovers (in side panel)
                 hoverAddWaypoint = addWaypointBtn.getGlobalBounds().contains(mx, my);
@@ -1058,10 +1143,7 @@ public:
         window.draw(bottomPanel);
         
         // Title
-        sf::Text title;
-        title.setFont(font);
-        title.setString("Current Itinerary:");
-        title.setCharacterSize(18);
+        sf::Text& title = cachedText("Current Itinerary:", 18);
         title.setFillColor(sf::Color::White);
         title.setPosition(20.f, 710.f);
         window.draw(title);
@@ -1095,10 +1177,7 @@ public:
                 window.draw(box);
                 
                 // Draw port name (larger, cleaner font - use even size for clarity)
-                sf::Text portText;
-                portText.setFont(font);
-                portText.setString(graph->ports[portIdx].name);
-                portText.setCharacterSize(16);
+                sf::Text& portText = cachedText(graph->ports[portIdx].name, 16);
                 portText.setFillColor(sf::Color(220, 230, 255));
                 
                 // Center text in box (account for text baseline offset)
@@ -1139,10 +1218,7 @@ public:
             }
         } else {
             // No itinerary booked yet
-            sf::Text emptyText;
-            emptyText.setFont(font);
-            emptyText.setString("No route booked yet. Find a route and click 'Book Route' to create an itinerary.");
-            emptyText.setCharacterSize(14);
+            sf::Text& emptyText = cachedText("No route booked yet. Find a route and click 'Book Route' to create an itinerary.", 14);
             emptyText.setFillColor(sf::Color(150, 150, 150));
             emptyText.setPosition(20.f, 755.f);
             window.draw(emptyText);
@@ -1158,7 +1234,8 @@ public:
         int totalRoutes = 0;
         double minCost = 1e18, maxCost = 0, totalCost = 0;
         int minDuration = 999999, maxDuration = 0;
-        SimpleVector<int> uniquePortIndices;
+        SimpleVector<int> uniquePortIndices(&frameArena);  // In first-seen order for the list below
+        companyPortsSeen.clear();
 
         // Iterate through all edges to gather company stats
         for (int i = 0; i < graph->ports.size(); i++) {
@@ -1175,20 +1252,10 @@ public:
                     if (route->durationMinutes < minDuration) minDuration = route->durationMinutes;
                     if (route->durationMinutes > maxDuration) maxDuration = route->durationMinutes;
 
-                    // Track unique origin port
-                    bool foundOrigin = false;
-                    for (int j = 0; j < uniquePortIndices.size(); j++) {
-                        if (uniquePortIndices[j] == i) { foundOrigin = true; break; }
-                    }
-                    if (!foundOrigin) uniquePortIndices.push_back(i);
-
-                    // Track unique destination port
+                    // Track unique origin and destination ports
+                    if (companyPortsSeen.insert(i)) uniquePortIndices.push_back(i);
                     int destIdx = edge->data.destinationPortIndex;
-                    bool foundDest = false;
-                    for (int j = 0; j < uniquePortIndices.size(); j++) {
-                        if (uniquePortIndices[j] == destIdx) { foundDest = true; break; }
-                    }
-                    if (!foundDest) uniquePortIndices.push_back(destIdx);
+                    if (companyPortsSeen.insert(destIdx)) uniquePortIndices.push_back(destIdx);
                 }
                 edge = edge->next;
             }
@@ -1200,13 +1267,9 @@ public:
         double avgCost = (totalRoutes > 0) ? totalCost / totalRoutes : 0;
 
         // Title
-        sf::Text title;
-        title.setFont(font);
         string titleStr = (selectedCompanyFilter == "ALL") ? "All Companies Overview" : selectedCompanyFilter + " - Route Information";
-        title.setString(titleStr);
-        title.setCharacterSize(16);
+        sf::Text& title = cachedText(titleStr, 16, sf::Text::Bold);
         title.setFillColor(sf::Color(100, 200, 255));
-        title.setStyle(sf::Text::Bold);
         title.setPosition(20.f, 710.f);
         window.draw(title);
 
@@ -1216,20 +1279,13 @@ public:
         float lineSpacing = 18.f;
 
         auto drawStatLine = [&](const string& label, const string& value, sf::Color valueColor) {
-            sf::Text labelText;
-            labelText.setFont(font);
-            labelText.setString(label);
-            labelText.setCharacterSize(13);
+            sf::Text& labelText = cachedText(label, 13);
             labelText.setFillColor(sf::Color(180, 180, 180));
             labelText.setPosition(statsX, statsY);
             window.draw(labelText);
 
-            sf::Text valueText;
-            valueText.setFont(font);
-            valueText.setString(value);
-            valueText.setCharacterSize(13);
+            sf::Text& valueText = cachedText(value, 13, sf::Text::Bold);
             valueText.setFillColor(valueColor);
-            valueText.setStyle(sf::Text::Bold);
             valueText.setPosition(statsX + 110.f, statsY);
             window.draw(valueText);
 
@@ -1255,12 +1311,8 @@ public:
         float portsX = 320.f;
         float portsY = 708.f;
 
-        sf::Text portsTitle;
-        portsTitle.setFont(font);
-        portsTitle.setString("Ports Served:");
-        portsTitle.setCharacterSize(15);
+        sf::Text& portsTitle = cachedText("Ports Served:", 15, sf::Text::Bold);
         portsTitle.setFillColor(sf::Color(255, 200, 100));
-        portsTitle.setStyle(sf::Text::Bold);
         portsTitle.setPosition(portsX, portsY);
         window.draw(portsTitle);
 
@@ -1273,20 +1325,12 @@ public:
         float currentTextY = textStartY;
         
         for (int i = 0; i < uniquePortIndices.size(); i++) {
-            string portName = graph->ports[uniquePortIndices[i]].name;
+            const string& name = graph->ports[uniquePortIndices[i]].name;
             
             // Add comma separator except for first item
-            if (i > 0) {
-                portName = ",  " + portName;
-            }
-            
-            sf::Text portText;
-            portText.setFont(font);
-            portText.setString(portName);
-            portText.setCharacterSize(14);
-            portText.setFillColor(sf::Color(180, 210, 255));  // Light blue - more vibrant
+            sf::Text* portText = (i > 0) ? &cachedText(",  " + name, 14) : &cachedText(name, 14);
             
-            sf::FloatRect textBounds = portText.getLocalBounds();
+            sf::FloatRect textBounds = portText->getLocalBounds();
             
             // Check if we need to wrap to next line
             if (currentTextX + textBounds.width > textStartX + maxTextWidth && i > 0) {
@@ -1294,26 +1338,23 @@ public:
                 currentTextY += lineHeight;
                 
                 // Remove leading comma for wrapped line
-                portName = graph->ports[uniquePortIndices[i]].name;
-                portText.setString(portName);
+                portText = &cachedText(name, 14);
             }
+            portText->setFillColor(sf::Color(180, 210, 255));  // Light blue - more vibrant
             
             // Stop if we exceed vertical space
             if (currentTextY > 835.f) {
-                sf::Text moreText;
-                moreText.setFont(font);
-                moreText.setString(" ..." + to_string(uniquePortIndices.size() - i) + " more");
-                moreText.setCharacterSize(13);
+                sf::Text& moreText = cachedText(" ..." + to_string(uniquePortIndices.size() - i) + " more", 13);
                 moreText.setFillColor(sf::Color(120, 120, 120));
                 moreText.setPosition(currentTextX, currentTextY);
                 window.draw(moreText);
                 break;
             }
             
-            portText.setPosition(currentTextX, currentTextY);
-            window.draw(portText);
+            portText->setPosition(currentTextX, currentTextY);
+            window.draw(*portText);
             
-            currentTextX += portText.getLocalBounds().width + 2.f;
+            currentTextX += portText->getLocalBounds().width + 2.f;
         }
 
     }
@@ -1324,10 +1365,7 @@ public:
         if (hoverBack) backButton.setFillColor(sf::Color(230, 110, 90));
         else backButton.setFillColor(sf::Color(200, 80, 60));
         window.draw(backButton);
-        sf::Text backText;
-        backText.setFont(font);
-        backText.setString("BACK");
-        backText.setCharacterSize(16);
+        sf::Text& backText = cachedText("BACK", 16);
         backText.setFillColor(sf::Color::White);
         backText.setPosition(backButton.getPosition().x + 15.f, backButton.getPosition().y + 8.f);
         window.draw(backText);
@@ -1336,12 +1374,8 @@ public:
         window.draw(sidePanel);
         
         // Title
-        sf::Text title;
-        title.setFont(font);
-        title.setString("Select Company");
-        title.setCharacterSize(22);
+        sf::Text& title = cachedText("Select Company", 22, sf::Text::Bold);
         title.setFillColor(sf::Color::White);
-        title.setStyle(sf::Text::Bold);
         title.setPosition(1065.f, 20.f);
         window.draw(title);
         
@@ -1351,10 +1385,7 @@ public:
             btn.setFillColor(isSelected ? sf::Color(60, 120, 200, 100) : sf::Color(40, 40, 48));
             window.draw(btn);
             
-            sf::Text btnText;
-            btnText.setFont(font);
-            btnText.setString(label);
-            btnText.setCharacterSize(14);
+            sf::Text& btnText = cachedText(label, 14);
             // Update text color
             btnText.setFillColor(isSelected ? sf::Color::White : sf::Color(160, 160, 160));
             btnText.setPosition(btn.getPosition().x + 10.f, btn.getPosition().y + 8.f);
@@ -1415,10 +1446,7 @@ public:
             tooltipBg.setOutlineThickness(1.5f);
             window.draw(tooltipBg);
 
-            sf::Text tooltipText;
-            tooltipText.setFont(font);
-            tooltipText.setString(tooltipStr);
-            tooltipText.setCharacterSize(12);
+            sf::Text& tooltipText = cachedText(tooltipStr, 12);
             tooltipText.setFillColor(sf::Color::White);
             tooltipText.setPosition(tooltipX + 5, tooltipY + 5);
             window.draw(tooltipText);
@@ -1451,12 +1479,8 @@ public:
         window.draw(legendBox);
         
         // Title
-        sf::Text legendTitle;
-        legendTitle.setFont(font);
-        legendTitle.setString("MAP LEGEND");
-        legendTitle.setCharacterSize(16);
+        sf::Text& legendTitle = cachedText("MAP LEGEND", 16, sf::Text::Bold);
         legendTitle.setFillColor(sf::Color::White);
-        legendTitle.setStyle(sf::Text::Bold);
         legendTitle.setPosition(legendX + 10.f, legendY + 10.f);
         window.draw(legendTitle);
         
@@ -1472,10 +1496,7 @@ public:
             circle.setPosition(legendX + 15.f, itemY);
             window.draw(circle);
             
-            sf::Text text;
-            text.setFont(font);
-            text.setString(label);
-            text.setCharacterSize(12);
+            sf::Text& text = cachedText(label, 12);
             text.setFillColor(sf::Color::White);
             text.setPosition(legendX + 35.f, itemY - 2.f);  // Align with circle center
             window.draw(text);
@@ -1490,10 +1511,7 @@ public:
             line.setPosition(legendX + 12.f, itemY + 6.f);
             window.draw(line);
             
-            sf::Text text;
-            text.setFont(font);
-            text.setString(label);
-            text.setCharacterSize(12);
+            sf::Text& text = cachedText(label, 12);
             text.setFillColor(sf::Color::White);
             text.setPosition(legendX + 35.f, itemY - 2.f);  // Align with line center
             window.draw(text);
@@ -1536,17 +1554,15 @@ public:
         window.draw(mapSprite);
         
         // Draw all ports as small magenta dots
-        for (int i = 0; i < graph->ports.size(); i++) {
-            Port& port = graph->ports[i];
-            sf::CircleShape circle(3.0f);
-            circle.setPosition(static_cast<float>(port.x) - 3.0f, static_cast<float>(port.y) - 3.0f);
-            circle.setFillColor(sf::Color::Magenta);
-            window.draw(circle);
-        }
+        drawPortMarkers();
         
-        // Draw waypoint markers
+        // Draw waypoint markers (one draw), then their numbers
+        SimpleVector<int> waypointPorts(&frameArena);
+        waypointPorts.reserve(multiLegWaypoints.size());
+        markerMesh.clear();
         for (int i = 0; i < multiLegWaypoints.size(); i++) {
             int portIdx = graph->getIndex(multiLegWaypoints[i]);
+            waypointPorts.push_back(portIdx);
             if (portIdx == -1) continue;
             
             Port& port = graph->ports[portIdx];
@@ -1565,21 +1581,19 @@ public:
                 borderColor = sf::Color(50, 80, 150);  // Dark blue border
             }
             
-            // Draw larger circle for waypoint
-            sf::CircleShape marker(8.0f);
-            marker.setPosition(static_cast<float>(port.x) - 8.0f, static_cast<float>(port.y) - 8.0f);
-            marker.setFillColor(waypointColor);
-            marker.setOutlineColor(borderColor);
-            marker.setOutlineThickness(2.f);
-            window.draw(marker);
+            // Larger circle for waypoint
+            appendRingedDisc(markerMesh, sf::Vector2f(static_cast<float>(port.x), static_cast<float>(port.y)),
+                             8.0f, waypointColor, 2.0f, borderColor);
+        }
+        window.draw(markerMesh);
+        
+        for (int i = 0; i < waypointPorts.size(); i++) {
+            if (waypointPorts[i] == -1) continue;
+            Port& port = graph->ports[waypointPorts[i]];
             
             // Draw waypoint number (black text for contrast)
-            sf::Text numText;
-            numText.setFont(font);
-            numText.setString(to_string(i + 1));
-            numText.setCharacterSize(12);
+            sf::Text& numText = cachedText(to_string(i + 1), 12, sf::Text::Bold);
             numText.setFillColor(sf::Color::Black);
-            numText.setStyle(sf::Text::Bold);
             sf::FloatRect numBounds = numText.getLocalBounds();
             // Better centering accounting for text baseline
             numText.setPosition(
@@ -1591,54 +1605,30 @@ public:
         
         // Draw path if calculated
         if (lastMultiLegResult.isValid && lastMultiLegResult.segments.size() > 0) {
-            // Draw all segments as connected orange lines
+            // Draw all segments as connected orange lines (one draw)
+            pathMesh.clear();
             for (int seg = 0; seg < lastMultiLegResult.segments.size(); seg++) {
                 PathResult& segment = lastMultiLegResult.segments[seg];
-                
-                for (int i = 0; i < segment.path.size() - 1; i++) {
-                    int u = segment.path[i];
-                    int v = segment.path[i + 1];
-                    Port& fromPort = graph->ports[u];
-                    Port& toPort = graph->ports[v];
-                    
-                    for (int offset = -2; offset <= 2; offset++) {
-                        sf::VertexArray line(sf::Lines, 2);
-                        line[0].position = sf::Vector2f(
-                            static_cast<float>(fromPort.x) + offset * 0.3f,
-                            static_cast<float>(fromPort.y) + offset * 0.3f
-                        );
-                        line[0].color = sf::Color(230, 130, 30);
-                        line[1].position = sf::Vector2f(
-                            static_cast<float>(toPort.x) + offset * 0.3f,
-                            static_cast<float>(toPort.y) + offset * 0.3f
-                        );
-                        line[1].color = sf::Color(230, 130, 30);
-                        window.draw(line);
-                    }
-                }
+                appendPortPath(pathMesh, segment.path.data, segment.path.size(), 3.0f, sf::Color(230, 130, 30));
             }
+            window.draw(pathMesh);
             
             // Draw all intermediate ports along the path with blue markers and numbering
             // Build a list of all unique ports in order
-            SimpleVector<int> allPathPorts;
+            SmallVector<int, 32> allPathPorts;
+            pathPortsSeen.clear();
             for (int seg = 0; seg < lastMultiLegResult.segments.size(); seg++) {
                 PathResult& segment = lastMultiLegResult.segments[seg];
                 for (int i = 0; i < segment.path.size(); i++) {
-                    // Skip if this port is already in the list (avoid duplicates at waypoint junctions)
-                    bool alreadyAdded = false;
-                    for (int j = 0; j < allPathPorts.size(); j++) {
-                        if (allPathPorts[j] == segment.path[i]) {
-                            alreadyAdded = true;
-                            break;
-                        }
-                    }
-                    if (!alreadyAdded) {
+                    // Skip ports already listed (avoid duplicates at waypoint junctions)
+                    if (pathPortsSeen.insert(segment.path[i])) {
                         allPathPorts.push_back(segment.path[i]);
                     }
                 }
             }
             
-            // Draw markers for all ports in the path
+            // Draw markers for all ports in the path (one draw), then their numbers
+            markerMesh.clear();
             for (int i = 0; i < allPathPorts.size(); i++) {
                 int portIdx = allPathPorts[i];
                 Port& port = graph->ports[portIdx];
@@ -1657,21 +1647,17 @@ public:
                     borderColor = sf::Color(50, 80, 150);  // Dark blue border
                 }
                 
-                // Draw circle marker
-                sf::CircleShape marker(8.0f);
-                marker.setPosition(static_cast<float>(port.x) - 8.0f, static_cast<float>(port.y) - 8.0f);
-                marker.setFillColor(portColor);
-                marker.setOutlineColor(borderColor);
-                marker.setOutlineThickness(2.f);
-                window.draw(marker);
+                appendRingedDisc(markerMesh, sf::Vector2f(static_cast<float>(port.x), static_cast<float>(port.y)),
+                                 8.0f, portColor, 2.0f, borderColor);
+            }
+            window.draw(markerMesh);
+            
+            for (int i = 0; i < allPathPorts.size(); i++) {
+                Port& port = graph->ports[allPathPorts[i]];
                 
                 // Draw port number (black text for visibility)
-                sf::Text numText;
-                numText.setFont(font);
-                numText.setString(to_string(i + 1));
-                numText.setCharacterSize(12);
+                sf::Text& numText = cachedText(to_string(i + 1), 12, sf::Text::Bold);
                 numText.setFillColor(sf::Color::Black);
-                numText.setStyle(sf::Text::Bold);
                 sf::FloatRect numBounds = numText.getLocalBounds();
                 numText.setPosition(
                     std::floor(static_cast<float>(port.x) - numBounds.width / 2.0f - numBounds.left),
@@ -1727,10 +1713,7 @@ public:
             tooltipBg.setOutlineThickness(1.5f);
             window.draw(tooltipBg);
 
-            sf::Text tooltipText;
-            tooltipText.setFont(font);
-            tooltipText.setString(tooltipStr);
-            tooltipText.setCharacterSize(12);
+            sf::Text& tooltipText = cachedText(tooltipStr, 12);
             tooltipText.setFillColor(sf::Color::White);
             tooltipText.setPosition(tooltipX + 5, tooltipY + 5);
             window.draw(tooltipText);
@@ -1743,10 +1726,7 @@ public:
         if (hoverBack) backButton.setFillColor(sf::Color(230, 110, 90));
         else backButton.setFillColor(sf::Color(200, 80, 60));
         window.draw(backButton);
-        sf::Text backText;
-        backText.setFont(font);
-        backText.setString("BACK");
-        backText.setCharacterSize(16);
+        sf::Text& backText = cachedText("BACK", 16);
         backText.setFillColor(sf::Color::White);
         backText.setPosition(backButton.getPosition().x + 15.f, backButton.getPosition().y + 8.f);
         window.draw(backText);
@@ -1767,33 +1747,22 @@ public:
         }
         window.draw(addWaypointBtn);
         
-        sf::Text addText;
-        addText.setFont(font);
-        addText.setString("ADD");
-        addText.setCharacterSize(12);
+        sf::Text& addText = cachedText("ADD", 12, sf::Text::Bold);
         addText.setFillColor(sf::Color::White);
-        addText.setStyle(sf::Text::Bold);
         addText.setPosition(addWaypointBtn.getPosition().x + 8.f, addWaypointBtn.getPosition().y + 7.f);
         window.draw(addText);
         
         // Error message (if any) - positioned below input box (label at 15, box at 35, height 28 = ends at 63)
         if (!multiLegErrorMessage.empty()) {
-            sf::Text errorText;
-            errorText.setFont(font);
-            errorText.setString(multiLegErrorMessage);
-            errorText.setCharacterSize(12);
+            sf::Text& errorText = cachedText(multiLegErrorMessage, 12);
             errorText.setFillColor(sf::Color(255, 100, 100));
             errorText.setPosition(1065.f, 68.f);
             window.draw(errorText);
         }
         
         // Waypoint list title
-        sf::Text waypointTitle;
-        waypointTitle.setFont(font);
-        waypointTitle.setString("Waypoints:");
-        waypointTitle.setCharacterSize(18);
+        sf::Text& waypointTitle = cachedText("Waypoints:", 18, sf::Text::Bold);
         waypointTitle.setFillColor(sf::Color::White);
-        waypointTitle.setStyle(sf::Text::Bold);
         waypointTitle.setPosition(1065.f, 88.f);
         window.draw(waypointTitle);
         
@@ -1805,10 +1774,7 @@ public:
             float yPos = 120.f + i * 35.f;
             
             // Waypoint text
-            sf::Text wpText;
-            wpText.setFont(font);
-            wpText.setString(to_string(i + 1) + ". " + multiLegWaypoints[i]);
-            wpText.setCharacterSize(14);
+            sf::Text& wpText = cachedText(to_string(i + 1) + ". " + multiLegWaypoints[i], 14);
             wpText.setFillColor(sf::Color::White);
             wpText.setPosition(1070.f, yPos);
             window.draw(wpText);
@@ -1826,12 +1792,8 @@ public:
             
             window.draw(removeBtn);
             
-            sf::Text xText;
-            xText.setFont(font);
-            xText.setString("X");
-            xText.setCharacterSize(14);
+            sf::Text& xText = cachedText("X", 14, sf::Text::Bold);
             xText.setFillColor(sf::Color::White);
-            xText.setStyle(sf::Text::Bold);
             xText.setPosition(removeBtn.getPosition().x + 7.f, removeBtn.getPosition().y + 3.f);
             window.draw(xText);
         }
@@ -1846,12 +1808,8 @@ public:
         }
         window.draw(calcJourneyBtn);
         
-        sf::Text calcText;
-        calcText.setFont(font);
-        calcText.setString("Calculate Journey");
-        calcText.setCharacterSize(18);
+        sf::Text& calcText = cachedText("Calculate Journey", 18, sf::Text::Bold);
         calcText.setFillColor(sf::Color::White);
-        calcText.setStyle(sf::Text::Bold);
         sf::FloatRect calcBounds = calcText.getLocalBounds();
         calcText.setPosition(
             calcJourneyBtn.getPosition().x + (calcJourneyBtn.getSize().x - calcBounds.width) / 2.f,
@@ -1859,12 +1817,8 @@ public:
         );
         window.draw(calcText);
         // Algorithm label inside the Calculate Journey button
-        sf::Text algoText;
-        algoText.setFont(font);
-        algoText.setString("Dijkstra (Time)");
-        algoText.setCharacterSize(12);
+        sf::Text& algoText = cachedText("Dijkstra (Time)", 12, sf::Text::Bold);
         algoText.setFillColor(sf::Color::White);
-        algoText.setStyle(sf::Text::Bold);  // Make it bold
         sf::FloatRect algoBounds = algoText.getLocalBounds();
         algoText.setPosition(
             calcJourneyBtn.getPosition().x + (calcJourneyBtn.getSize().x - algoBounds.width) / 2.f,
@@ -1877,12 +1831,8 @@ public:
         
         if (lastMultiLegResult.isValid && lastMultiLegResult.segments.size() > 0) {
             // Title
-            sf::Text journeyTitle;
-            journeyTitle.setFont(font);
-            journeyTitle.setString("Multi-Leg Journey:");
-            journeyTitle.setCharacterSize(16);
+            sf::Text& journeyTitle = cachedText("Multi-Leg Journey:", 16, sf::Text::Bold);
             journeyTitle.setFillColor(sf::Color(255, 200, 100));
-            journeyTitle.setStyle(sf::Text::Bold);
             journeyTitle.setPosition(20.f, 710.f);
             window.draw(journeyTitle);
             
@@ -1901,10 +1851,7 @@ public:
                     if (i < segment.path.size() - 1) routeStr += " -> ";
                 }
                 
-                sf::Text segText;
-                segText.setFont(font);
-                segText.setString(routeStr);
-                segText.setCharacterSize(14);
+                sf::Text& segText = cachedText(routeStr, 14);
                 segText.setFillColor(sf::Color(180, 210, 255));  // Light blue, more vibrant
                 segText.setPosition(segX, segY);
                 window.draw(segText);
@@ -1930,51 +1877,33 @@ public:
             snprintf(costStr, sizeof(costStr), "$%.2f", lastMultiLegResult.totalCostWithCharges);
             
             // Draw "Total Time:" label
-            sf::Text timeLabel;
-            timeLabel.setFont(font);
-            timeLabel.setString("Total Time:");
-            timeLabel.setCharacterSize(15);
+            sf::Text& timeLabel = cachedText("Total Time:", 15);
             timeLabel.setFillColor(sf::Color(180, 180, 180));
             timeLabel.setPosition(totalsX, totalsY);
             window.draw(timeLabel);
             
             // Draw time value
-            sf::Text timeValue;
-            timeValue.setFont(font);
-            timeValue.setString(timeStr);
-            timeValue.setCharacterSize(15);
+            sf::Text& timeValue = cachedText(timeStr, 15, sf::Text::Bold);
             timeValue.setFillColor(sf::Color(200, 150, 255));
-            timeValue.setStyle(sf::Text::Bold);
             timeValue.setPosition(totalsX + 95.f, totalsY);
             window.draw(timeValue);
             
             // Draw "Total Cost:" label
-            sf::Text costLabel;
-            costLabel.setFont(font);
-            costLabel.setString("Total Cost:");
-            costLabel.setCharacterSize(15);
+            sf::Text& costLabel = cachedText("Total Cost:", 15);
             costLabel.setFillColor(sf::Color(180, 180, 180));
             costLabel.setPosition(totalsX, totalsY + 22.f);
             window.draw(costLabel);
             
             // Draw cost value
-            sf::Text costValue;
-            costValue.setFont(font);
-            costValue.setString(string(costStr));
-            costValue.setCharacterSize(15);
+            sf::Text& costValue = cachedText(costStr, 15, sf::Text::Bold);
             costValue.setFillColor(sf::Color(255, 200, 100));
-            costValue.setStyle(sf::Text::Bold);
             costValue.setPosition(totalsX + 95.f, totalsY + 22.f);
             window.draw(costValue);
             
         } else if (calculateAttempted && !lastMultiLegResult.isValid && multiLegWaypoints.size() >= 2) {
             // Show "Journey impossible" message in bottom panel
-            sf::Text impossibleText;
-            impossibleText.setFont(font);
-            impossibleText.setString("Journey impossible. No valid path found!");
-            impossibleText.setCharacterSize(16);
+            sf::Text& impossibleText = cachedText("Journey impossible. No valid path found!", 16, sf::Text::Bold);
             impossibleText.setFillColor(sf::Color(255, 100, 100));
-            impossibleText.setStyle(sf::Text::Bold);
             impossibleText.setPosition(20.f, 740.f);
             window.draw(impossibleText);
         }
@@ -1988,10 +1917,7 @@ public:
     void drawBookingUI() {
         // Draw back button
         window.draw(backButton);
-        sf::Text backText;
-        backText.setFont(font);
-        backText.setString("BACK");
-        backText.setCharacterSize(16);
+        sf::Text& backText = cachedText("BACK", 16);
         backText.setFillColor(sf::Color::White);
         backText.setPosition(backButton.getPosition().x + 15.f, backButton.getPosition().y + 8.f);
         window.draw(backText);
@@ -2026,11 +1952,7 @@ public:
         // Helper to draw a labeled button (centered text, modern styling)
         auto drawLabeledButton = [&](sf::RectangleShape& btn, const string& label, float textOffsetY) {
             window.draw(btn);
-            sf::Text t;
-            t.setFont(font);
-            t.setString(label);
-            t.setCharacterSize(16);
-            t.setStyle(sf::Text::Bold);
+            sf::Text& t = cachedText(label, 16, sf::Text::Bold);
             t.setFillColor(sf::Color::White);
             // Center text horizontally and vertically with floor for crisp rendering
             sf::FloatRect textBounds = t.getLocalBounds();
@@ -2052,8 +1974,7 @@ public:
         drawLabeledButton(findRouteButton, "Find Route", 10.f);
         drawLabeledButton(bookButton, "Book Route", 10.f);
 
-        // Compute stats for display (use getSelectedDay() for day value)
-        int displayDay = getSelectedDay();
+        // Compute stats for display
         double computedCost = 0.0;
         bool costComputed = false;
         long long totalMinutes = -1;
@@ -2074,8 +1995,7 @@ public:
                 double layoverCosts = 0.0;
                 
                 // Start time calculation
-                double decemberStartMinutes = 482400.0;
-                double currentArrival = decemberStartMinutes + (getSelectedDay() - 1) * 1440.0;
+                double currentArrival = getSelectedDayStart();
                 
                 for (int i = 0; i < lastResult.path.size() - 1; i++) {
                     int u = lastResult.path[i];
@@ -2086,23 +2006,12 @@ public:
                             Route* r = en->data.routeData;
                             routeCosts += en->data.weight;
                             
-                            // Parse route times
-                            Date depDate = parseDate(r->departureDate);
-                            int depTimeMin = timeToMinutes(r->depTime);
-                            int arrTimeMin = timeToMinutes(r->arrTime);
-                            long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-                            long long arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
-                            
-                            // Handle overnight routes
-                            if (arrTimeMin < depTimeMin) {
-                                arrivalDatetime += 1440;
-                            }
+                            // Compiled route times (overnight sailings already adjusted)
+                            long long departureDatetime = r->departureDatetime;
+                            long long arrivalDatetime = r->arrivalDatetime;
                             
                             // Find next valid departure (weekly cycling)
-                            while (departureDatetime < currentArrival) {
-                                departureDatetime += 10080;
-                                arrivalDatetime += 10080;
-                            }
+                            alignSailing(graph->timetable, departureDatetime, arrivalDatetime, currentArrival);
                             
                             // Calculate port charges at intermediate ports
                             if (i > 0 && i < lastResult.path.size() - 1) {
@@ -2134,8 +2043,7 @@ public:
                 double waitTime = 0.0;
                 
                 // Start time calculation
-                double decemberStartMinutes = 482400.0;
-                double currentArrival = decemberStartMinutes + (getSelectedDay() - 1) * 1440.0;
+                double currentArrival = getSelectedDayStart();
                 
                 for (int i = 0; i < lastResult.path.size() - 1; i++) {
                     int u = lastResult.path[i];
@@ -2146,23 +2054,12 @@ public:
                             Route* r = en->data.routeData;
                             sailTime += r->durationMinutes;
                             
-                            // Parse route times
-                            Date depDate = parseDate(r->departureDate);
-                            int depTimeMin = timeToMinutes(r->depTime);
-                            int arrTimeMin = timeToMinutes(r->arrTime);
-                            long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-                            long long arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
-                            
-                            // Handle overnight routes
-                            if (arrTimeMin < depTimeMin) {
-                                arrivalDatetime += 1440;
-                            }
+                            // Compiled route times (overnight sailings already adjusted)
+                            long long departureDatetime = r->departureDatetime;
+                            long long arrivalDatetime = r->arrivalDatetime;
                             
                             // Find next valid departure (weekly cycling)
-                            while (departureDatetime < currentArrival) {
-                                departureDatetime += 10080;
-                                arrivalDatetime += 10080;
-                            }
+                            alignSailing(graph->timetable, departureDatetime, arrivalDatetime, currentArrival);
                             
                             // Calculate wait time for intermediate ports (not at start)
                             if (i > 0) {
@@ -2200,11 +2097,8 @@ public:
         window.draw(statsBox);
         
         auto addLine = [&](const string& label, const string& value, float offsetY) {
-            sf::Text t;
-            t.setFont(font);
-            t.setCharacterSize(14);
+            sf::Text& t = cachedText(label + value, 14);
             t.setFillColor(sf::Color::White);
-            t.setString(label + value);
             t.setPosition(statX, statY + offsetY);
             window.draw(t);
         };
@@ -2254,15 +2148,12 @@ public:
         addLine("Hops: ", hopsStr.str(), 90.f);
 
         // Current selection info - centered between stats box bottom and live feed box top
-        sf::Text sel;
-        sel.setFont(font);
-        sel.setCharacterSize(14);  // Slightly smaller for compact layout
-        sel.setFillColor(sf::Color(255, 200, 100));
         std::string selStr = "Start: ";
         selStr += (startPortIdx != -1) ? graph->ports[startPortIdx].name : "None";
         selStr += " | End: ";
         selStr += (endPortIdx != -1) ? graph->ports[endPortIdx].name : "None";
-        sel.setString(selStr);
+        sf::Text& sel = cachedText(selStr, 14);  // Slightly smaller for compact layout
+        sel.setFillColor(sf::Color(255, 200, 100));
         // Center horizontally on the panel (panel is 260 wide starting at statX-5)
         sf::FloatRect selBounds = sel.getLocalBounds();
         float selX = std::floor((statX - 5.f) + (260.f - selBounds.width) / 2.f - selBounds.left);
@@ -2330,11 +2221,8 @@ public:
                     float lineHeight = 25.f;
                     
                     auto drawInfoLine = [&](const string& label, const string& value, int lineNum) {
-                        sf::Text text;
-                        text.setFont(font);
-                        text.setCharacterSize(14);
+                        sf::Text& text = cachedText(label + value, 14);
                         text.setFillColor(sf::Color::White);
-                        text.setString(label + value);
                         text.setPosition(textX, textY + lineNum * lineHeight);
                         window.draw(text);
                     };
@@ -2375,8 +2263,7 @@ public:
                     
                     if (!isStartPort && currentRoute) {
                         // Calculate actual wait time using weekly cycling
-                        double decemberStartMinutes = 482400.0;
-                        double currentArrival = decemberStartMinutes + (getSelectedDay() - 1) * 1440.0;
+                        double currentArrival = getSelectedDayStart();
                         
                         // Trace through path to get actual arrival time at current port
                         for (int i = 0; i < lastDisplayedSegment; i++) {
@@ -2386,23 +2273,11 @@ public:
                             while (en != nullptr) {
                                 if (en->data.destinationPortIndex == v) {
                                     Route* r = en->data.routeData;
-                                    Date depDate = parseDate(r->departureDate);
-                                    int depTimeMin = timeToMinutes(r->depTime);
-                                    int arrTimeMin = timeToMinutes(r->arrTime);
-                                    long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
-                                    long long arrivalDatetime = dateTimeToMinutes(depDate, arrTimeMin);
-                                    
-                                    if (arrTimeMin < depTimeMin) {
-                                        arrivalDatetime += 1440;
-                                    }
+                                    long long departureDatetime = r->departureDatetime;
+                                    long long arrivalDatetime = r->arrivalDatetime;
                                     
                                     // Apply cycling with 1-cycle limit
-                                    int cycleCount = 0;
-                                    while (departureDatetime < currentArrival && cycleCount < 1) {
-                                        departureDatetime += 10080;
-                                        arrivalDatetime += 10080;
-                                        cycleCount++;
-                                    }
+                                    alignSailing(graph->timetable, departureDatetime, arrivalDatetime, currentArrival, 1);
                                     
                                     currentArrival = (double)arrivalDatetime;
                                     break;
@@ -2412,16 +2287,11 @@ public:
                         }
                         
                         // Now calculate wait for the current segment
-                        Date depDate = parseDate(currentRoute->departureDate);
-                        int depTimeMin = timeToMinutes(currentRoute->depTime);
-                        long long departureDatetime = dateTimeToMinutes(depDate, depTimeMin);
+                        long long departureDatetime = currentRoute->departureDatetime;
+                        long long arrivalDatetime = currentRoute->arrivalDatetime;
                         
                         // Apply cycling
-                        int cycleCount = 0;
-                        while (departureDatetime < currentArrival && cycleCount < 1) {
-                            departureDatetime += 10080;
-                            cycleCount++;
-                        }
+                        alignSailing(graph->timetable, departureDatetime, arrivalDatetime, currentArrival, 1);
                         
                         waitMins = departureDatetime - currentArrival;
                         
@@ -2438,11 +2308,8 @@ public:
                     float lineHeight = 25.f;
                     
                     auto drawInfoLine = [&](const string& label, const string& value, int lineNum) {
-                        sf::Text text;
-                        text.setFont(font);
-                        text.setCharacterSize(14);
+                        sf::Text& text = cachedText(label + value, 14);
                         text.setFillColor(sf::Color::White);
-                        text.setString(label + value);
                         text.setPosition(textX, textY + lineNum * lineHeight);
                         window.draw(text);
                     };
@@ -2531,10 +2398,7 @@ public:
             tooltipBg.setOutlineThickness(1.5f);
             window.draw(tooltipBg);
 
-            sf::Text tooltipText;
-            tooltipText.setFont(font);
-            tooltipText.setString(tooltipStr);
-            tooltipText.setCharacterSize(12);
+            sf::Text& tooltipText = cachedText(tooltipStr, 12);
             tooltipText.setFillColor(sf::Color::White);
             tooltipText.setPosition(tooltipX + 5, tooltipY + 5);
             window.draw(tooltipText);
@@ -2592,60 +2456,87 @@ public:
         window.draw(ship);
     }
 
-    // Draw the company routes world: map with filtered routes
-    void drawCompanyWorld() {
-        window.clear(sf::Color::Black);
-        window.draw(mapSprite);
-        
-        // Draw routes filtered by selected company
+    // Cached text for (string, size, style, font); set colour and position, then draw
+    sf::Text& cachedText(StringView str, unsigned size, sf::Uint32 style = sf::Text::Regular) {
+        return texts.get(font, str, size, style);
+    }
+
+    sf::Text& cachedText(StringView str, unsigned size, sf::Uint32 style, const sf::Font& textFont) {
+        return texts.get(textFont, str, size, style);
+    }
+
+    // All ports as magenta dots in one draw, with the given start/end ports highlighted
+    void drawPortMarkers(int startPort = -1, int endPort = -1) {
+        if (!portMarkers.isCurrent(*graph)) {
+            portMarkers.build(*graph, 3.0f, sf::Color::Magenta);
+        }
+        portMarkers.clearHighlights(*graph);
+        if (endPort != startPort) portMarkers.highlight(*graph, endPort, 5.0f, sf::Color::Red);
+        portMarkers.highlight(*graph, startPort, 5.0f, sf::Color::Green);
+        window.draw(portMarkers.vertices);
+    }
+
+    // Tessellate the route through the given ports into out (an sf::Triangles array)
+    void appendPortPath(sf::VertexArray& out, const int* path, int count, float width, sf::Color color) {
+        SimpleVector<sf::Vector2f> points(&frameArena);
+        points.reserve(count);
+        for (int i = 0; i < count; i++) {
+            Port& port = graph->ports[path[i]];
+            points.push_back(sf::Vector2f(static_cast<float>(port.x), static_cast<float>(port.y)));
+        }
+        appendPolyline(out, points.data, points.size(), width, color);
+    }
+
+    // Company screen route lines: every route faint for "ALL", else only the selected company's
+    void rebuildCompanyRoutes() {
+        bool showAll = selectedCompanyFilter == "ALL";
+        companyRoutes.begin(*graph, -1, selectedCompanyFilter, showAll ? sf::Lines : sf::Triangles);
+        sf::Color routeColor = showAll ? sf::Color(100, 200, 255, 150)   // Blue, more transparent
+                                       : sf::Color(100, 200, 255, 255);  // Blue, fully opaque
         for (int i = 0; i < graph->ports.size(); i++) {
             Node<Edge>* edge = graph->adjList[i].head;
             while (edge != nullptr) {
-                Port& p1 = graph->ports[i];
-                Port& p2 = graph->ports[edge->data.destinationPortIndex];
-                
-                // Filter logic
-                bool shouldDraw = false;
-                sf::Color routeColor;
-                float thickness = 1.5f;
-                
-                if (selectedCompanyFilter == "ALL") {
-                    shouldDraw = true;
-                    // Use faint blue for "ALL"
-                    routeColor = sf::Color(100, 200, 255, 150);  // Blue, more transparent
-                    thickness = 1.5f;
+                Port& from = graph->ports[i];
+                Port& to = graph->ports[edge->data.destinationPortIndex];
+                if (showAll) {
+                    companyRoutes.addLine(from, to, routeColor);
                 } else if (edge->data.routeData->company == selectedCompanyFilter) {
-                    shouldDraw = true;
-                    routeColor = sf::Color(100, 200, 255, 255);  // Blue, fully opaque
-                    thickness = 3.0f;
+                    companyRoutes.addThickLine(from, to, 3.0f, routeColor);
                 }
-                
-                if (shouldDraw) {
-                    sf::Vertex line[] = {
-                        sf::Vertex(sf::Vector2f(static_cast<float>(p1.x), static_cast<float>(p1.y)), routeColor),
-                        sf::Vertex(sf::Vector2f(static_cast<float>(p2.x), static_cast<float>(p2.y)), routeColor)
-                    };
-                    
-                    // Draw multiple times for thickness
-                    for (int t = 0; t < static_cast<int>(thickness); t++) {
-                        window.draw(line, 2, sf::Lines);
-                    }
-                }
-                
                 edge = edge->next;
             }
         }
-        
-        // Draw ports
+    }
+
+    // Booking screen route lines: routes from the selected start port in blue, the rest as a ghost network
+    void rebuildBookingRoutes() {
+        bookingRoutes.begin(*graph, startPortIdx, "", sf::Lines);
         for (int i = 0; i < graph->ports.size(); i++) {
-            Port& port = graph->ports[i];
-            sf::CircleShape circle(3.0f);  // Same size as booking screen
-            circle.setPosition(static_cast<float>(port.x) - 3.0f, static_cast<float>(port.y) - 3.0f);
-            circle.setFillColor(sf::Color::Magenta);
-            window.draw(circle);
+            sf::Color lineColor = (i == startPortIdx) ? sf::Color(100, 200, 255)
+                                                      : sf::Color(200, 200, 200, 30);
+            Node<Edge>* current = graph->adjList[i].head;
+            while (current != nullptr) {
+                bookingRoutes.addLine(graph->ports[i], graph->ports[current->data.destinationPortIndex], lineColor);
+                current = current->next;
+            }
         }
     }
 
+    // Draw the company routes world: map with filtered routes
+    void drawCompanyWorld() {
+        window.clear(sf::Color::Black);
+        window.draw(mapSprite);
+        
+        // Draw routes filtered by selected company
+        if (!companyRoutes.isCurrent(*graph, -1, selectedCompanyFilter)) {
+            rebuildCompanyRoutes();
+        }
+        window.draw(companyRoutes.vertices);
+        
+        // Draw ports
+        drawPortMarkers();
+    }
+
     // Draw the entire world: map, routes, and ports
     void drawBookingWorld() {
         // Clear with dark ocean background
@@ -2655,102 +2546,23 @@ public:
         window.draw(mapSprite);
         
         // Draw Routes (edges) with smart visibility
-        for (int i = 0; i < graph->ports.size(); i++) {
-            Port& srcPort = graph->ports[i];
-            
-            // Iterate through the adjacency list for this port
-            Node<Edge>* current = graph->adjList[i].head;
-            while (current != nullptr) {
-                int destIndex = current->data.destinationPortIndex;
-                Port& destPort = graph->ports[destIndex];
-                
-                // Determine line color based on selection
-                sf::Color lineColor;
-                if (i == startPortIdx) {
-                    // Highlight routes from selected start port in Blue
-                    lineColor = sf::Color(100, 200, 255);
-                } else {
-                    // Default: very faint/transparent white (ghost network)
-                    lineColor = sf::Color(200, 200, 200, 30);
-                }
-                
-                // Create a line from source to destination
-                sf::VertexArray line(sf::Lines, 2);
-                line[0].position = sf::Vector2f(static_cast<float>(srcPort.x), static_cast<float>(srcPort.y));
-                line[0].color = lineColor;
-                line[1].position = sf::Vector2f(static_cast<float>(destPort.x), static_cast<float>(destPort.y));
-                line[1].color = lineColor;
-                
-                window.draw(line);
-                
-                current = current->next;
-            }
+        if (!bookingRoutes.isCurrent(*graph, startPortIdx, "")) {
+            rebuildBookingRoutes();
         }
+        window.draw(bookingRoutes.vertices);
 
-        // Highlight the found path
+        // Highlight the found path, and the animated path if animating (orange, one draw)
+        pathMesh.clear();
         if (pathFound && lastResult.path.size() >= 2) {
-            for (int i = 0; i < lastResult.path.size() - 1; i++) {
-                int u = lastResult.path[i];
-                int v = lastResult.path[i + 1];
-                Port& fromPort = graph->ports[u];
-                Port& toPort = graph->ports[v];
-
-                for (int offset = -2; offset <= 2; offset++) {
-                    sf::VertexArray thickLine(sf::Lines, 2);
-                    thickLine[0].position = sf::Vector2f(
-                        static_cast<float>(fromPort.x) + offset * 0.3f, 
-                        static_cast<float>(fromPort.y) + offset * 0.3f
-                    );
-                    thickLine[0].color = sf::Color(230, 130, 30);
-                    thickLine[1].position = sf::Vector2f(
-                        static_cast<float>(toPort.x) + offset * 0.3f, 
-                        static_cast<float>(toPort.y) + offset * 0.3f
-                    );
-                    thickLine[1].color = sf::Color(230, 130, 30);
-                    window.draw(thickLine);
-                }
-            }
+            appendPortPath(pathMesh, lastResult.path.data, lastResult.path.size(), 3.0f, sf::Color(230, 130, 30));
         }
-        
-        // Draw the animated path if animating
         if (isAnimating && currentPath.size() >= 2) {
-            for (int i = 0; i < currentPath.size() - 1; i++) {
-                Port& from = graph->ports[currentPath[i]];
-                Port& to = graph->ports[currentPath[i + 1]];
-                
-                sf::VertexArray pathLine(sf::Lines, 2);
-                pathLine[0].position = sf::Vector2f(static_cast<float>(from.x), static_cast<float>(from.y));
-                pathLine[0].color = sf::Color(230, 130, 30);  // Orange
-                pathLine[1].position = sf::Vector2f(static_cast<float>(to.x), static_cast<float>(to.y));
-                pathLine[1].color = sf::Color(230, 130, 30);  // Orange
-                window.draw(pathLine);
-            }
+            appendPortPath(pathMesh, currentPath.data, currentPath.size(), 1.5f, sf::Color(230, 130, 30));
         }
+        window.draw(pathMesh);
 
-        // Draw Ports
-        for (int i = 0; i < graph->ports.size(); i++) {
-            Port& port = graph->ports[i];
-
-            // Draw port circle
-            sf::CircleShape portCircle(3.0f);  // Radius of 3
-            
-            // Color logic based on selection
-            if (i == startPortIdx) {
-                portCircle.setFillColor(sf::Color::Green);
-                portCircle.setRadius(5.0f);  // Slightly larger for selected
-            } else if (i == endPortIdx) {
-                portCircle.setFillColor(sf::Color::Red);
-                portCircle.setRadius(5.0f);
-            } else {
-                portCircle.setFillColor(sf::Color::Magenta);
-            }
-            
-            // Center the circle on the port coordinates
-            float radius = portCircle.getRadius();
-            portCircle.setPosition(static_cast<float>(port.x) - radius, static_cast<float>(port.y) - radius);
-            
-            window.draw(portCircle);
-        }
+        // Draw Ports: selected start in green, end in red, both slightly larger
+        drawPortMarkers(startPortIdx, endPortIdx);
 
         // Draw ship if animating
         drawShip();
@@ -2772,12 +2584,8 @@ public:
         window.clear(sf::Color(0, 20, 53));
         
         // Title
-        sf::Text title;
-        title.setFont(titleFont);
-        title.setString("OCEAN ROUTE NAVIGATOR");
-        title.setCharacterSize(48);
+        sf::Text& title = cachedText("OCEAN ROUTE NAVIGATOR", 48, sf::Text::Bold, titleFont);
         title.setFillColor(sf::Color(100, 200, 255));
-        title.setStyle(sf::Text::Bold);
         
         sf::FloatRect titleBounds = title.getLocalBounds();
         float titleX = std::floor((1350.f - titleBounds.width) / 2.f - titleBounds.left);
@@ -2804,16 +2612,19 @@ public:
         menuBtnMultiLeg.setFillColor(highlightMultiLeg ? sf::Color(160, 120, 200) : sf::Color(120, 80, 150));
         menuBtnCompanyRoutes.setFillColor(highlightCompany ? sf::Color(90, 170, 110) : sf::Color(60, 120, 80));
         menuBtnExit.setFillColor(highlightExit ? sf::Color(200, 80, 80) : sf::Color(150, 50, 50));
+
+        // Screens that need the graph stay greyed out while it loads
+        if (!graphApplied) {
+            menuBtnRouteBooking.setFillColor(sf::Color(60, 65, 75));
+            menuBtnMultiLeg.setFillColor(sf::Color(60, 65, 75));
+            menuBtnCompanyRoutes.setFillColor(sf::Color(60, 65, 75));
+        }
         
         // Draw menu buttons
         auto drawMenuButton = [&](sf::RectangleShape& btn, const string& label) {
             window.draw(btn);
-            sf::Text btnText;
-            btnText.setFont(font);
-            btnText.setString(label);
-            btnText.setCharacterSize(24);
+            sf::Text& btnText = cachedText(label, 24, sf::Text::Bold);
             btnText.setFillColor(sf::Color::White);
-            btnText.setStyle(sf::Text::Bold);
             
             sf::FloatRect textBounds = btnText.getLocalBounds();
             float textX = std::floor(btn.getPosition().x + (btn.getSize().x - textBounds.width) / 2.f - textBounds.left);
@@ -2826,6 +2637,29 @@ public:
         drawMenuButton(menuBtnMultiLeg, "Multi-leg Routes");
         drawMenuButton(menuBtnCompanyRoutes, "Company Routes");
         drawMenuButton(menuBtnExit, "Exit");
+
+        // Load progress under the buttons
+        if (!graphApplied) {
+            float barX = (1350.f - 400.f) / 2.f;
+            float barY = 750.f;
+            sf::RectangleShape barBack(sf::Vector2f(400.f, 12.f));
+            barBack.setPosition(barX, barY);
+            barBack.setFillColor(sf::Color(30, 45, 70));
+            barBack.setOutlineColor(sf::Color(100, 160, 220));
+            barBack.setOutlineThickness(1.f);
+            window.draw(barBack);
+
+            sf::RectangleShape barFill(sf::Vector2f(400.f * loader->progress / 100.f, 12.f));
+            barFill.setPosition(barX, barY);
+            barFill.setFillColor(sf::Color(100, 200, 255));
+            window.draw(barFill);
+
+            sf::Text& status = cachedText(string(loader->status) + "...", 16);
+            status.setFillColor(sf::Color(180, 200, 220));
+            sf::FloatRect statusBounds = status.getLocalBounds();
+            status.setPosition(std::floor((1350.f - statusBounds.width) / 2.f - statusBounds.left), barY + 22.f);
+            window.draw(status);
+        }
         
         window.display();
     }
@@ -2845,26 +2679,132 @@ public:
         }
     }
 
-    // Main SFML event loop
+    void setRouteStream(RouteStream* stream) {
+        routeStream = stream;
+    }
+
+    // Ask for a redraw on the next pass of the loop
+    void invalidate() {
+        frameDirty = true;
+    }
+
+    // Current hover highlighting, for comparison with the last pass
+    void hoverState(HoverState& out) const {
+        bool flags[HoverState::FLAG_COUNT] = {
+            hoverMenuBooking, hoverMenuCompany, hoverMenuMultiLeg, hoverMenuExit, hoverBack,
+            hoverDijkstraCost, hoverDijkstraTime, hoverAStarCost, hoverAStarTime, hoverFindRoute,
+            hoverBook, hoverMinusDate, hoverPlusDate, hoverAddWaypoint, hoverCalcJourney
+        };
+        for (int i = 0; i < HoverState::FLAG_COUNT; i++) out.flags[i] = flags[i];
+        out.removeWaypoint.clear();
+        for (int i = 0; i < hoverRemoveWaypoint.size(); i++) {
+            out.removeWaypoint.push_back(hoverRemoveWaypoint[i]);
+        }
+        out.portIdx = hoverPortIdx;
+        out.menuIndex = selectedMenuIndex;
+    }
+
+    bool anyInputFocused() const {
+        InputBox* inputs[] = { originPortInput, destPortInput, dayInput, monthInput, yearInput, multiLegSearchInput };
+        for (InputBox* input : inputs) {
+            if (input != nullptr && input->isFocused()) return true;
+        }
+        return false;
+    }
+
+    // Frames are needed back to back (at the capped rate)
+    bool isAnimatingFrame() const {
+        return currentScreen == BOOKING && isAnimating;
+    }
+
+    // Something outside the event queue can change the picture, so check back periodically
+    bool needsPolling() const {
+        return !assetsApplied || !graphApplied || routeStream != nullptr || anyInputFocused();
+    }
+
+    void handleEvent(sf::Event& event) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        }
+        handleInput(event);
+        // A plain mouse move only matters if it changes hover highlighting
+        // (checked after the batch) or moves a tooltip along with the cursor
+        if (event.type != sf::Event::MouseMoved || hoverPortIdx != -1) {
+            invalidate();
+        }
+    }
+
+    // Main SFML event loop: redraws only when something changed
     void run() {
         while (window.isOpen()) {
+            frameArena.reset();
+
+            bool wasLoaded = assetsApplied && graphApplied;
+            applyLoadedData();
+            int progress = loader->progress;
+            if ((assetsApplied && graphApplied) != wasLoaded || progress != lastLoadProgress) {
+                lastLoadProgress = progress;
+                invalidate();
+            }
+
+            // Fold in streamed schedule changes before anything reads the graph this frame
+            if (graphApplied && routeStream != nullptr && routeStream->applyPending(*graph) > 0) {
+                resultComputed = false;  // Cached search result may use stale sailings
+                invalidate();
+            }
+
+            if (anyInputFocused() && blinkClock.getElapsedTime().asMilliseconds() >= CURSOR_BLINK_MS) {
+                invalidate();
+            }
+
             sf::Event event;
-            while (window.pollEvent(event)) {
-                if (event.type == sf::Event::Closed) {
-                    window.close();
+            if (!frameDirty && !isAnimatingFrame()) {
+                if (needsPolling()) {
+                    // Short sleeps so typing shows up at once; give up at the poll
+                    // interval (or the next cursor blink) to recheck everything else
+                    int waitMs = POLL_INTERVAL_MS;
+                    if (anyInputFocused()) {
+                        int untilBlink = CURSOR_BLINK_MS - blinkClock.getElapsedTime().asMilliseconds();
+                        if (untilBlink < waitMs) waitMs = untilBlink;
+                    }
+                    sf::Clock waited;
+                    bool gotEvent = window.pollEvent(event);
+                    while (!gotEvent && waited.getElapsedTime().asMilliseconds() < waitMs) {
+                        sf::sleep(sf::milliseconds(EVENT_SLICE_MS));
+                        gotEvent = window.pollEvent(event);
+                    }
+                    if (!gotEvent) continue;
+                    handleEvent(event);
+                } else if (window.waitEvent(event)) {
+                    handleEvent(event);
                 }
-                handleInput(event);
             }
+            while (window.pollEvent(event)) {
+                handleEvent(event);
+            }
+            if (!window.isOpen()) break;
             
             // Update hover for all screens
             updateHover();
+            HoverState hover;
+            hoverState(hover);
+            if (hover != lastHoverState) {
+                lastHoverState = hover;
+                invalidate();
+            }
             
             // Update animation only in booking screen
-            if (currentScreen == BOOKING) {
+            if (isAnimatingFrame()) {
                 updateAnimation();
+                invalidate();
             }
             
-            draw();
+            if (frameDirty) {
+                frameDirty = false;
+                blinkClock.restart();
+                draw();
+                texts.endFrame();
+            }
         }
     }
 };
@@ -1,53 +1,60 @@
 #include <iostream>
-#include "../include/SimpleVector.h"
-#include "../include/DataStructs.h"
-#include "../include/FileParser.h"
-#include "../include/Graph.h"
+#include "../include/DataLoader.h"
+#include "../include/RouteStream.h"
 #include "../include/Visualizer.h"
 
 using namespace std;
 
-int main() {
-    // Load data using FileParser
-    SimpleVector<Port> ports;
-    SimpleVector<Route> routes;
-    FileParser parser;
-
-    cout << "Loading Ports..." << endl;
-    parser.loadPorts("../data/PortCharges.txt", ports);
-    
-    cout << "Loading Routes..." << endl;
-    parser.loadRoutes("../data/Routes.txt", routes);
-
-    cout << "Total Ports Loaded: " << ports.size() << endl;
-    cout << "Total Routes Loaded: " << routes.size() << endl;
-
-    // Build the Graph
-    Graph graph;
-
-    // Add all ports to the graph
-    for (int i = 0; i < ports.size(); i++) {
-        graph.addPort(ports[i]);
-    }
-    cout << "Added " << graph.ports.size() << " ports to graph." << endl;
-
-    // Add all routes as edges to the graph
-    for (int i = 0; i < routes.size(); i++) {
-        graph.addEdge(routes[i].origin, routes[i].destination, routes[i].cost, &routes[i]);
+int main(int argc, char* argv[]) {
+    const string portsFile = "../data/PortCharges.txt";
+    string routesFile = "../data/Routes.txt";
+    const string coordinatesFile = "../data/PortCoordinates.txt";
+
+    // Optional: --routes <file> picks another route feed (.cols = columnar),
+    // --stream <file> tails an append-only file of schedule changes,
+    // --weekly treats every route as a sailing that repeats each week
+    string streamFile;
+    bool weeklyTimetable = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--routes" && i + 1 < argc) {
+            routesFile = argv[++i];
+        } else if (arg == "--stream" && i + 1 < argc) {
+            streamFile = argv[++i];
+        } else if (arg == "--weekly") {
+            weeklyTimetable = true;
+        } else {
+            cout << "Error: Unknown argument " << arg << endl;
+            cout << "Usage: " << argv[0] << " [--routes <file>] [--stream <file>] [--weekly]" << endl;
+            return 1;
+        }
     }
-    cout << "Added edges from " << routes.size() << " routes." << endl;
-
-    // Initialize traffic - populate ports with dummy ships
-    cout << "Initializing port traffic..." << endl;
-    graph.initializeTraffic();
-
-    // Display the graph structure
-    graph.displayGraph();
+    // Assets and the graph load on a background thread; the menu opens
+    // straight away and the other screens unlock once the graph is ready
+    DataLoader loader;
+    loader.paths.portsFile = portsFile;
+    loader.paths.routesFile = routesFile;
+    loader.paths.coordinatesFile = coordinatesFile;
+    loader.paths.snapshotFile = "../data/Graph.snap";
+    loader.paths.mapImageFile = "../assets/world_map.png";
+    loader.paths.iconImageFile = "../assets/icon.jpg";
+    loader.paths.fontFile = "../assets/arial.ttf";
+    loader.weeklyTimetable = weeklyTimetable;
+    loader.start();
 
     // Create the visualizer and run
     cout << "Starting OceanRoute Nav Visualizer..." << endl;
-    OceanVisualizer visualizer(&graph);
+    OceanVisualizer visualizer(&loader);
+
+    RouteStream stream;
+    if (!streamFile.empty() && stream.start(streamFile)) {
+        cout << "Streaming schedule changes from " << streamFile << endl;
+        visualizer.setRouteStream(&stream);
+    }
+
     visualizer.run();
+    stream.stop();
+    loader.join();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,304 @@
+// Generates large synthetic datasets in the formats the app reads, for
+// reproducible scaling measurements. The same seed and options always
+// produce byte-identical files.
+//
+//   DatasetGenerator [--ports N] [--routes N] [--hubs N] [--weeks N]
+//                    [--start DD/MM/YYYY] [--seed N] [--out DIR]
+//
+// Writes DIR/PortCharges.txt, DIR/PortCoordinates.txt, DIR/Routes.txt and
+// DIR/Routes.cols (columnar binary). The network is hub-and-spoke: every
+// port belongs to its nearest hub, and routes are trunk services between
+// hubs, feeders between a port and its hub, and short regional hops. Each
+// service sails weekly; --weeks N writes N dated sailings per service
+// (run the app with --weekly to treat one week as recurring).
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../include/SimpleVector.h"
+#include "../include/DataStructs.h"
+#include "../include/RouteColumns.h"
+#include "../include/StringInterner.h"
+
+using namespace std;
+
+// splitmix64: small, fast and fully determined by the seed
+struct Random {
+    uint64_t state;
+
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double real() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Uniform in [0, n)
+    int below(int n) {
+        return static_cast<int>(real() * n);
+    }
+
+    double range(double lo, double hi) {
+        return lo + (hi - lo) * real();
+    }
+};
+
+struct GeneratedPort {
+    string name;
+    double lat, lon;
+    int dailyCharge;
+    int hub;  // Index of the hub this port feeds (itself for hubs)
+};
+
+// Carrier mix, weighted roughly by fleet share
+const int CARRIER_COUNT = 10;
+const char* CARRIERS[CARRIER_COUNT] = {
+    "MSC", "MaerskLine", "CMA_CGM", "COSCO", "HapagLloyd",
+    "ONE", "Evergreen", "YangMing", "ZIM", "PIL"
+};
+const double CARRIER_WEIGHTS[CARRIER_COUNT] = {20, 17, 13, 11, 7, 6, 6, 3, 2.5, 1.5};
+const double CARRIER_PRICE[CARRIER_COUNT] = {1.00, 1.05, 0.98, 0.92, 1.10, 1.00, 0.95, 0.94, 1.02, 0.90};
+
+int pickCarrier(Random& rng) {
+    double total = 0;
+    for (int i = 0; i < CARRIER_COUNT; i++) total += CARRIER_WEIGHTS[i];
+    double x = rng.real() * total;
+    for (int i = 0; i < CARRIER_COUNT; i++) {
+        x -= CARRIER_WEIGHTS[i];
+        if (x < 0) return i;
+    }
+    return CARRIER_COUNT - 1;
+}
+
+// Pronounceable single-token name, unique across the dataset
+string makePortName(Random& rng, StringInterner& used) {
+    const char* onsets[] = {"B", "D", "K", "L", "M", "N", "P", "R", "S", "T", "V", "Z", "Br", "Gr", "St", "Tr", "Kh", "Sh"};
+    const char* vowels[] = {"a", "e", "i", "o", "u", "ai", "ea", "ou"};
+    const char* codas[] = {"", "", "n", "r", "s", "l", "m", "sk", "nd", "port", "haven", "burg", "ville"};
+    while (true) {
+        string name;
+        int syllables = 2 + rng.below(2);
+        for (int s = 0; s < syllables; s++) {
+            string onset = onsets[rng.below(18)];
+            if (s > 0) onset[0] = static_cast<char>(onset[0] - 'A' + 'a');
+            name += onset;
+            name += vowels[rng.below(8)];
+        }
+        name += codas[rng.below(13)];
+        if (used.find(name) == -1) {
+            used.intern(name);
+            return name;
+        }
+        // Common collisions get a numeric suffix instead of another draw
+        name += to_string(used.size());
+        if (used.find(name) == -1) {
+            used.intern(name);
+            return name;
+        }
+    }
+}
+
+double distanceKm(const GeneratedPort& a, const GeneratedPort& b) {
+    const double toRad = 3.14159265358979323846 / 180.0;
+    double dLat = (b.lat - a.lat) * toRad;
+    double dLon = (b.lon - a.lon) * toRad;
+    double h = sin(dLat / 2) * sin(dLat / 2) + cos(a.lat * toRad) * cos(b.lat * toRad) * sin(dLon / 2) * sin(dLon / 2);
+    return 2 * 6371.0 * asin(sqrt(h));
+}
+
+bool parseCount(const string& text, long long& out) {
+    int value;
+    if (!parseIntChars(text.data(), text.data() + text.size(), value) || value < 0) return false;
+    out = value;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    long long portCount = 10000;
+    long long routeCount = 1000000;
+    long long hubCount = -1;  // Default: one hub per 200 ports
+    long long weeks = 1;
+    long long seed = 42;
+    Date start = {1, 12, 2024};
+    string outDir = ".";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cout << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        bool ok = true;
+        if (arg == "--ports") ok = parseCount(value, portCount);
+        else if (arg == "--routes") ok = parseCount(value, routeCount);
+        else if (arg == "--hubs") ok = parseCount(value, hubCount);
+        else if (arg == "--weeks") ok = parseCount(value, weeks);
+        else if (arg == "--seed") ok = parseCount(value, seed);
+        else if (arg == "--start") ok = parseDateChars(value.data(), value.data() + value.size(), start);
+        else if (arg == "--out") outDir = value;
+        else {
+            cout << "Error: Unknown argument " << arg << endl;
+            cout << "Usage: " << argv[0] << " [--ports N] [--routes N] [--hubs N] [--weeks N] [--start DD/MM/YYYY] [--seed N] [--out DIR]" << endl;
+            return 1;
+        }
+        if (!ok) {
+            cout << "Error: Invalid value for " << arg << ": " << value << endl;
+            return 1;
+        }
+    }
+    if (hubCount < 0) hubCount = portCount / 200 > 4 ? portCount / 200 : 4;
+    if (portCount < 2 || hubCount < 1 || hubCount > portCount || weeks < 1) {
+        cout << "Error: Need at least 2 ports, 1 to <ports> hubs and 1 week" << endl;
+        return 1;
+    }
+
+    Random rng(static_cast<uint64_t>(seed));
+    StringInterner usedNames;
+    SimpleVector<GeneratedPort> ports;
+
+    // Hubs are spread over shipping latitudes; other ports cluster around them
+    for (long long i = 0; i < portCount; i++) {
+        GeneratedPort p;
+        p.name = makePortName(rng, usedNames);
+        if (i < hubCount) {
+            p.lat = rng.range(-45, 60);
+            p.lon = rng.range(-180, 180);
+            p.hub = static_cast<int>(i);
+            p.dailyCharge = 900 + rng.below(700);
+        } else {
+            const GeneratedPort& anchor = ports[rng.below(static_cast<int>(hubCount))];
+            p.lat = anchor.lat + rng.range(-12, 12);
+            p.lon = anchor.lon + rng.range(-18, 18);
+            if (p.lat > 75) p.lat = 75;
+            if (p.lat < -60) p.lat = -60;
+            if (p.lon > 180) p.lon -= 360;
+            if (p.lon < -180) p.lon += 360;
+            p.hub = -1;
+            p.dailyCharge = 200 + rng.below(900);
+        }
+        ports.push_back(p);
+    }
+
+    // Every spoke feeds its nearest hub
+    SimpleVector<SimpleVector<int>> members;
+    for (long long h = 0; h < hubCount; h++) {
+        members.push_back(SimpleVector<int>());
+        members[h].push_back(static_cast<int>(h));
+    }
+    for (int i = static_cast<int>(hubCount); i < ports.size(); i++) {
+        int best = 0;
+        double bestKm = 1e18;
+        for (int h = 0; h < hubCount; h++) {
+            double km = distanceKm(ports[i], ports[h]);
+            if (km < bestKm) {
+                bestKm = km;
+                best = h;
+            }
+        }
+        ports[i].hub = best;
+        members[best].push_back(i);
+    }
+
+    string portsPath = outDir + "/PortCharges.txt";
+    string coordinatesPath = outDir + "/PortCoordinates.txt";
+    ofstream portsOut(portsPath);
+    ofstream coordinatesOut(coordinatesPath);
+    if (!portsOut.is_open() || !coordinatesOut.is_open()) {
+        cout << "Error: Could not write to " << outDir << endl;
+        return 1;
+    }
+    coordinatesOut.setf(ios::fixed);
+    coordinatesOut.precision(4);
+    for (int i = 0; i < ports.size(); i++) {
+        portsOut << ports[i].name << " " << ports[i].dailyCharge << "\n";
+        coordinatesOut << ports[i].name << " " << ports[i].lat << " " << ports[i].lon << "\n";
+    }
+    portsOut.close();
+    coordinatesOut.close();
+
+    // Date strings for every day a sailing can fall on
+    long long firstDay = daysFromCivil(start.year, start.month, start.day);
+    SimpleVector<string> dayNames;
+    for (long long d = 0; d < weeks * 7; d++) {
+        dayNames.push_back(formatDate(civilFromDays(firstDay + d)));
+    }
+
+    string routesPath = outDir + "/Routes.txt";
+    ofstream routesOut(routesPath);
+    if (!routesOut.is_open()) {
+        cout << "Error: Could not write " << routesPath << endl;
+        return 1;
+    }
+    RouteColumnsWriter columns;
+
+    long long services = (routeCount + weeks - 1) / weeks;
+    long long written = 0;
+    for (long long s = 0; s < services && written < routeCount; s++) {
+        // 25% trunk (hub to hub), 60% feeder (port to/from its hub), 15% regional
+        int from, to;
+        double kind = rng.real();
+        if (kind < 0.25 || ports.size() == hubCount) {
+            from = rng.below(static_cast<int>(hubCount));
+            to = rng.below(static_cast<int>(hubCount));
+        } else {
+            int spoke = static_cast<int>(hubCount) + rng.below(ports.size() - static_cast<int>(hubCount));
+            SimpleVector<int>& region = members[ports[spoke].hub];
+            from = spoke;
+            to = (kind < 0.85) ? ports[spoke].hub : region[rng.below(region.size())];
+            if (rng.below(2) == 0) {
+                int t = from;
+                from = to;
+                to = t;
+            }
+        }
+        if (from == to) {
+            to = (to + 1) % ports.size();
+        }
+
+        // Sailing time at ~35 km/h, clamped to what the HH:MM format can express
+        double km = distanceKm(ports[from], ports[to]);
+        int duration = static_cast<int>(km / 35.0 * 60.0) / 15 * 15;
+        if (duration < 60) duration = 60;
+        if (duration > 1425) duration = 1425;
+
+        int carrier = pickCarrier(rng);
+        int cost = static_cast<int>((1500 + km * 1.8) * CARRIER_PRICE[carrier] * rng.range(0.9, 1.1));
+        int weekday = rng.below(7);
+        int depMin = rng.below(96) * 15;
+        int arrMin = (depMin + duration) % 1440;
+        string depTime = formatTime(depMin);
+        string arrTime = formatTime(arrMin);
+
+        for (long long w = 0; w < weeks && written < routeCount; w++) {
+            long long day = w * 7 + weekday;
+            routesOut << ports[from].name << " " << ports[to].name << " " << dayNames[static_cast<int>(day)] << " "
+                      << depTime << " " << arrTime << " " << cost << " " << CARRIERS[carrier] << "\n";
+
+            long long departure = (firstDay + day) * 1440 + depMin;
+            columns.add(ports[from].name, ports[to].name, departure, departure + duration, cost, CARRIERS[carrier]);
+            written++;
+        }
+    }
+    routesOut.close();
+    if (!routesOut) {
+        cout << "Error: Failed writing " << routesPath << endl;
+        return 1;
+    }
+    if (!columns.finish(outDir + "/Routes.cols")) {
+        return 1;
+    }
+
+    cout << "Generated " << ports.size() << " ports (" << hubCount << " hubs) and "
+         << written << " routes in " << outDir << " (seed " << seed << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Stress test and throughput benchmark for ConcurrentQueue under
+// contention, against a mutex-guarded SimpleQueue as the baseline.
+//
+//   QueueBenchmark [--producers N] [--consumers N] [--items N] [--capacity N]
+//
+// Every producer pushes --items values tagged with its id and a sequence
+// number. Consumers check that each producer's values arrive in order and
+// exactly once (via per-producer counts and checksums). Exits non-zero if
+// either queue loses, duplicates or reorders anything.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "../include/SimpleVector.h"
+#include "../include/SimpleQueue.h"
+#include "../include/ConcurrentQueue.h"
+#include "../include/DataStructs.h"
+
+using namespace std;
+
+// Baseline: the single-threaded queue behind one lock, same interface
+struct LockedQueue {
+    mutex lock;
+    SimpleQueue<uint64_t> queue;
+    int capacity;
+
+    explicit LockedQueue(int cap) : capacity(cap) {}
+
+    bool tryPush(uint64_t value) {
+        lock_guard<mutex> guard(lock);
+        if (queue.size() >= capacity) return false;
+        queue.push(value);
+        return true;
+    }
+
+    bool tryPop(uint64_t& out) {
+        lock_guard<mutex> guard(lock);
+        if (queue.empty()) return false;
+        out = queue.front();
+        queue.pop();
+        return true;
+    }
+};
+
+// Per-consumer tallies, padded so consumers do not false-share
+struct alignas(64) ConsumerTally {
+    SimpleVector<uint64_t> lastSeq;   // Per producer, 0 = nothing seen yet
+    SimpleVector<uint64_t> count;
+    SimpleVector<uint64_t> sum;
+    long long outOfOrder = 0;
+};
+
+template <typename Queue>
+bool runCase(const char* name, Queue& queue, int producers, int consumers, long long items) {
+    atomic<int> producersLeft(producers);
+    atomic<bool> start(false);
+    SimpleVector<ConsumerTally> tallies;
+    tallies.resize(consumers);
+    for (int c = 0; c < consumers; c++) {
+        tallies[c].lastSeq.resize(producers, 0);
+        tallies[c].count.resize(producers, 0);
+        tallies[c].sum.resize(producers, 0);
+    }
+
+    SimpleVector<thread*> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(new thread([&, p]() {
+            while (!start) this_thread::yield();
+            for (long long seq = 1; seq <= items; seq++) {
+                uint64_t value = (static_cast<uint64_t>(p) << 40) | static_cast<uint64_t>(seq);
+                while (!queue.tryPush(value)) this_thread::yield();
+            }
+            producersLeft--;
+        }));
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.push_back(new thread([&, c]() {
+            ConsumerTally& tally = tallies[c];
+            while (!start) this_thread::yield();
+            uint64_t value;
+            while (true) {
+                // Read before popping: if producers were already done, an empty pop means drained
+                bool producersDone = producersLeft == 0;
+                if (queue.tryPop(value)) {
+                    int p = static_cast<int>(value >> 40);
+                    uint64_t seq = value & ((1ULL << 40) - 1);
+                    if (seq <= tally.lastSeq[p]) tally.outOfOrder++;
+                    tally.lastSeq[p] = seq;
+                    tally.count[p]++;
+                    tally.sum[p] += seq;
+                } else if (producersDone) {
+                    break;
+                } else {
+                    this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    auto begin = chrono::steady_clock::now();
+    start = true;
+    for (int t = 0; t < threads.size(); t++) {
+        threads[t]->join();
+        delete threads[t];
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    bool ok = true;
+    uint64_t expectedSum = static_cast<uint64_t>(items) * static_cast<uint64_t>(items + 1) / 2;
+    for (int p = 0; p < producers; p++) {
+        uint64_t count = 0, sum = 0;
+        for (int c = 0; c < consumers; c++) {
+            count += tallies[c].count[p];
+            sum += tallies[c].sum[p];
+        }
+        if (count != static_cast<uint64_t>(items) || sum != expectedSum) {
+            cout << "Error: " << name << ": producer " << p << " delivered " << count << " of " << items << " items" << endl;
+            ok = false;
+        }
+    }
+    for (int c = 0; c < consumers; c++) {
+        if (tallies[c].outOfOrder > 0) {
+            cout << "Error: " << name << ": consumer " << c << " saw " << tallies[c].outOfOrder << " out-of-order items" << endl;
+            ok = false;
+        }
+    }
+
+    double total = static_cast<double>(items) * producers;
+    cout << "  " << name << ": " << (total / seconds / 1e6) << " M items/s (" << seconds * 1000 << " ms)"
+         << (ok ? "" : "  FAILED") << endl;
+    return ok;
+}
+
+bool parseCount(const string& text, int& out) {
+    return parseIntChars(text.data(), text.data() + text.size(), out) && out > 0;
+}
+
+int main(int argc, char* argv[]) {
+    int producers = 4;
+    int consumers = 4;
+    int items = 1000000;  // Per producer
+    int capacity = 1024;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cout << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        bool ok;
+        if (arg == "--producers") ok = parseCount(value, producers);
+        else if (arg == "--consumers") ok = parseCount(value, consumers);
+        else if (arg == "--items") ok = parseCount(value, items);
+        else if (arg == "--capacity") ok = parseCount(value, capacity);
+        else {
+            cout << "Error: Unknown argument " << arg << endl;
+            cout << "Usage: " << argv[0] << " [--producers N] [--consumers N] [--items N] [--capacity N]" << endl;
+            return 1;
+        }
+        if (!ok) {
+            cout << "Error: Invalid value for " << arg << ": " << value << endl;
+            return 1;
+        }
+    }
+
+    cout << producers << " producer(s), " << consumers << " consumer(s), " << items
+         << " items each, capacity " << capacity << endl;
+
+    ConcurrentQueue<uint64_t> lockFree(capacity);
+    LockedQueue locked(lockFree.capacity());
+    bool ok = runCase("ConcurrentQueue", lockFree, producers, consumers, items);
+    ok = runCase("mutex + SimpleQueue", locked, producers, consumers, items) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// Converts a Routes.txt feed into the columnar route format, and prints
+// per-column statistics for an existing columnar file.
+//
+//   RouteConverter <routes.txt> <routes.cols>
+//   RouteConverter --stats <routes.cols>
+
+#include <iostream>
+#include "../include/SimpleVector.h"
+#include "../include/DataStructs.h"
+#include "../include/FileParser.h"
+#include "../include/MappedFile.h"
+#include "../include/RouteColumns.h"
+
+using namespace std;
+
+const char* COLUMN_NAMES[ROUTE_COLUMN_COUNT] = {
+    "origin", "destination", "departure", "arrival", "cost", "company"
+};
+
+int convert(const string& textFile, const string& columnsFile) {
+    SimpleVector<Route> routes;
+    FileParser parser;
+    parser.loadRoutes(textFile, routes);
+    if (routes.size() == 0) {
+        cout << "Error: No routes read from " << textFile << endl;
+        return 1;
+    }
+    if (!RouteColumnsFile::write(columnsFile, routes)) {
+        return 1;
+    }
+
+    FileStamp textStamp = {}, columnsStamp = {};
+    if (!getFileStamp(textFile, textStamp)) {
+        cout << "Error: Could not stat " << textFile << endl;
+        return 1;
+    }
+    if (!getFileStamp(columnsFile, columnsStamp)) {
+        cout << "Error: Could not stat " << columnsFile << endl;
+        return 1;
+    }
+    cout << "Wrote " << routes.size() << " routes to " << columnsFile << " ("
+         << textStamp.size << " -> " << columnsStamp.size << " bytes)" << endl;
+    return 0;
+}
+
+int stats(const string& columnsFile) {
+    RouteColumnsFile columns;
+    if (!columns.open(columnsFile)) {
+        return 1;
+    }
+    cout << columns.rowCount() << " routes, " << columns.portNames.size() << " ports, "
+         << columns.companyNames.size() << " companies" << endl;
+    for (int c = 0; c < ROUTE_COLUMN_COUNT; c++) {
+        cout << "  " << COLUMN_NAMES[c] << ": " << columns.header.columnBytes[c] << " bytes" << endl;
+    }
+
+    // Single-column scan: only the cost bytes are decoded
+    ColumnReader cost = columns.column(COLUMN_COST);
+    long long total = 0;
+    int64_t value;
+    int rows = 0;
+    while (rows < columns.rowCount() && cost.next(value)) {
+        total += value;
+        rows++;
+    }
+    if (rows != columns.rowCount()) {
+        cout << "Error: Cost column ends at row " << rows << endl;
+        return 1;
+    }
+    cout << "Total cost: " << total << ", average " << (rows > 0 ? total / rows : 0) << endl;
+
+    // Timetable span from the departure column alone
+    ColumnReader departure = columns.column(COLUMN_DEPARTURE);
+    int64_t first = 0, last = 0;
+    for (int row = 0; row < columns.rowCount() && departure.next(value); row++) {
+        if (row == 0 || value < first) first = value;
+        if (row == 0 || value > last) last = value;
+    }
+    if (columns.rowCount() > 0) {
+        Date firstDate, lastDate;
+        int firstTime, lastTime;
+        minutesToDateTime(first, firstDate, firstTime);
+        minutesToDateTime(last, lastDate, lastTime);
+        cout << "Departures: " << formatDate(firstDate) << " " << formatTime(firstTime)
+             << " to " << formatDate(lastDate) << " " << formatTime(lastTime) << endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && string(argv[1]) == "--stats") {
+        return stats(argv[2]);
+    }
+    if (argc == 3) {
+        return convert(argv[1], argv[2]);
+    }
+    cout << "Usage: " << argv[0] << " <routes.txt> <routes.cols>" << endl;
+    cout << "       " << argv[0] << " --stats <routes.cols>" << endl;
+    return 1;
+}